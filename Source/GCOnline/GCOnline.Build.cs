@@ -35,7 +35,7 @@ public class GCOnline : ModuleRules
         PrivateDependencyModuleNames.AddRange(
             new string[]
             {
-                "DeveloperSettings", "ApplicationCore",
+                "DeveloperSettings", "ApplicationCore", "AssetRegistry",
 
                 "OnlineSubsystemUtils",
             }
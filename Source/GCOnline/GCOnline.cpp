@@ -2,6 +2,8 @@
 
 #include "GCOnline.h"
 
+#include "Lobby/Type/OnlineLobbyCreateTypes.h"
+
 IMPLEMENT_MODULE(FGCOnlineModule, GCOnline)
 
 
@@ -11,4 +13,5 @@ void FGCOnlineModule::StartupModule()
 
 void FGCOnlineModule::ShutdownModule()
 {
+	FLobbyMapNameCache::Shutdown();
 }
@@ -37,6 +37,18 @@ void UAsyncAction_CreateLobby::Activate()
 	HandleFailure();
 }
 
+void UAsyncAction_CreateLobby::Cancel()
+{
+	Super::Cancel();
+
+	// Stop the creation in progress, its completion is no longer broadcast
+
+	if (Subsystem.IsValid())
+	{
+		Subsystem->CancelLobbyOperation(Request.Get());
+	}
+}
+
 void UAsyncAction_CreateLobby::HandleFailure()
 {
 	if (ShouldBroadcastDelegates())
@@ -37,6 +37,18 @@ void UAsyncAction_JoinLobby::Activate()
 	HandleFailure();
 }
 
+void UAsyncAction_JoinLobby::Cancel()
+{
+	Super::Cancel();
+
+	// Stop the join in progress, its completion is no longer broadcast
+
+	if (Subsystem.IsValid())
+	{
+		Subsystem->CancelLobbyOperation(Request.Get());
+	}
+}
+
 void UAsyncAction_JoinLobby::HandleFailure()
 {
 	if (ShouldBroadcastDelegates())
@@ -4,8 +4,12 @@
 
 #include "OnlineLobbySubsystem.h"
 #include "Type/OnlineLobbyResultTypes.h"
+#include "Type/OnlineLobbyRankingTypes.h"
+#include "OnlineDeveloperSettings.h"
 
+#include "Online/OnlineErrorDefinitions.h"
 #include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AsyncAction_QuickPlayLobby)
 
@@ -30,6 +34,24 @@ void UAsyncAction_QuickPlayLobby::Activate()
 {
 	if (Subsystem.IsValid() && IsRegistered() && PC.IsValid() && SearchReq && CreateReq)
 	{
+		CurrentSearchReq = SearchReq;
+		WideningStepIndex = INDEX_NONE;
+		FirstSearchStartTime = FPlatformTime::Seconds();
+		bHedgedCreateInFlight = false;
+		bAbandonHedgedCreate = false;
+		bWaitingForHedgedCreate = false;
+		bCompleted = false;
+
+		// Prepare the creation while searching if the search takes too long
+
+		const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+		auto* TimerManager{ GetTimerManager() };
+
+		if (bCanCreateLobby && DevSettings->IsQuickPlayHedgeEnabled() && TimerManager)
+		{
+			TimerManager->SetTimer(HedgeTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::StepD1_StartHedge), DevSettings->GetQuickPlayHedgeDelay(), false);
+		}
+
 		StepA1_SearchLobby();
 	}
 	else
@@ -42,6 +64,22 @@ void UAsyncAction_QuickPlayLobby::Cancel()
 {
 	bPendingCancel = true;
 
+	if (auto* TimerManager{ GetTimerManager() })
+	{
+		TimerManager->ClearTimer(WideningTimerHandle);
+	}
+
+	StopHedge();
+
+	// Cancel the lobby operations in progress, their completions are ignored since bPendingCancel is set
+
+	if (Subsystem.IsValid())
+	{
+		Subsystem->CancelLobbyOperation(CurrentSearchReq);
+		Subsystem->CancelLobbyOperation(CurrentJoinReq);
+		Subsystem->CancelLobbyOperation(CreateReq);
+	}
+
 	if (ShouldBroadcastDelegates())
 	{
 		OnCancelled.Broadcast(PC.Get(), nullptr, FOnlineServiceResult());
@@ -55,7 +93,7 @@ void UAsyncAction_QuickPlayLobby::Cancel()
 
 void UAsyncAction_QuickPlayLobby::StepA1_SearchLobby()
 {
-	if (bPendingCancel)
+	if (bPendingCancel || bCompleted)
 	{
 		return;
 	}
@@ -67,7 +105,9 @@ void UAsyncAction_QuickPlayLobby::StepA1_SearchLobby()
 
 	// Start Search
 
-	if (!Subsystem->SearchLobby(PC.Get(), SearchReq, NewDelegate))
+	SearchStartTime = FPlatformTime::Seconds();
+
+	if (!Subsystem.IsValid() || !Subsystem->SearchLobby(PC.Get(), CurrentSearchReq, NewDelegate))
 	{
 		HandleFailure();
 	}
@@ -75,7 +115,7 @@ void UAsyncAction_QuickPlayLobby::StepA1_SearchLobby()
 
 void UAsyncAction_QuickPlayLobby::StepA2_SelectLobby(ULobbySearchRequest* SearchRequest, FOnlineServiceResult Result)
 {
-	if (bPendingCancel)
+	if (bPendingCancel || bCompleted)
 	{
 		return;
 	}
@@ -91,16 +131,37 @@ void UAsyncAction_QuickPlayLobby::StepA2_SelectLobby(ULobbySearchRequest* Search
 			HandleFailure();
 		}
 
-		// If an item exists in the search results, select the preferred lobby from it.
+		// If an item exists in the search results, try the candidates from the preferred lobby.
 
 		else if (ResultCount > 0)
 		{
-			StepB1_JoinLobby(ChoosePreferredLobby(SearchRequest->Results));
+			CandidateLobbies = RankCandidateLobbies(SearchRequest->Results);
+			NumJoinAttempts = 0;
+
+			const auto Deadline{ GetDefault<UOnlineDeveloperSettings>()->GetQuickPlayJoinDeadline() };
+			JoinDeadline = (Deadline > 0.0) ? FPlatformTime::Seconds() + Deadline : 0.0;
+
+			// Lobbies have been found, so there is no need to hedge any more
+
+			if (auto* TimerManager{ GetTimerManager() })
+			{
+				TimerManager->ClearTimer(HedgeTimerHandle);
+			}
+
+			// Leave the lobby being created speculatively before trying the candidates
+
+			if (bHedgedCreateInFlight)
+			{
+				bAbandonHedgedCreate = true;
+				return;
+			}
+
+			StepB3_JoinNextCandidate(FOnlineServiceResult());
 		}
 
-		// Create a new lobby if there is no preferred lobby in the search results.
+		// Widen the search, or create a new lobby if there is no preferred lobby in the search results.
 
-		else
+		else if (!StepA3_WidenSearch())
 		{
 			StepC1_CreateLobby();
 		}
@@ -111,9 +172,81 @@ void UAsyncAction_QuickPlayLobby::StepA2_SelectLobby(ULobbySearchRequest* Search
 	}
 }
 
-ULobbyResult* UAsyncAction_QuickPlayLobby::ChoosePreferredLobby(const TArray<ULobbyResult*>& Results)
+TArray<ULobbyResult*> UAsyncAction_QuickPlayLobby::RankCandidateLobbies(const TArray<ULobbyResult*>& Results)
 {
-	return Results[0];
+	// Use the views built by the search when they match the results
+
+	TArray<FLobbyView> Views;
+
+	if (CurrentSearchReq && (CurrentSearchReq->ResultViews.Num() == Results.Num()))
+	{
+		Views = CurrentSearchReq->ResultViews;
+	}
+	else
+	{
+		Views.Reserve(Results.Num());
+
+		for (const auto& Result : Results)
+		{
+			Views.Emplace(Result ? Result->MakeView() : FLobbyView());
+		}
+	}
+
+	// Rank candidates with the configured policy
+
+	FLobbyCandidateSnapshot Snapshot;
+	Snapshot.Build(Views, Subsystem->GetLobbyHistory(), FPlatformTime::Seconds());
+
+	const auto* RankingPolicy{ GetDefault<UOnlineDeveloperSettings>()->GetQuickPlayRankingPolicy() };
+	const auto RankedIndices{ RankingPolicy->RankCandidates(Snapshot) };
+
+	TArray<ULobbyResult*> RankedLobbies;
+	RankedLobbies.Reserve(RankedIndices.Num());
+
+	for (const auto& Index : RankedIndices)
+	{
+		RankedLobbies.Emplace(Results[Index]);
+	}
+
+	return RankedLobbies;
+}
+
+bool UAsyncAction_QuickPlayLobby::StepA3_WidenSearch()
+{
+	const auto NextStepIndex{ WideningStepIndex + 1 };
+
+	if (!SearchReq || !SearchReq->WideningSteps.IsValidIndex(NextStepIndex))
+	{
+		return false;
+	}
+
+	// Do not start a search that would begin after the deadline
+
+	const auto StartTime{ SearchStartTime + SearchReq->WideningSteps[NextStepIndex].Delay };
+
+	if ((SearchReq->WideningDeadline > 0.0f) && (StartTime > FirstSearchStartTime + SearchReq->WideningDeadline))
+	{
+		return false;
+	}
+
+	WideningStepIndex = NextStepIndex;
+	CurrentSearchReq = SearchReq->CreateWidenedRequest(WideningStepIndex, this);
+
+	// Wait for the rest of the delay if the previous search finished earlier
+
+	const auto RemainingTime{ StartTime - FPlatformTime::Seconds() };
+	auto* TimerManager{ GetTimerManager() };
+
+	if ((RemainingTime > 0.0) && TimerManager)
+	{
+		TimerManager->SetTimer(WideningTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::StepA1_SearchLobby), RemainingTime, false);
+	}
+	else
+	{
+		StepA1_SearchLobby();
+	}
+
+	return true;
 }
 
 
@@ -130,12 +263,16 @@ void UAsyncAction_QuickPlayLobby::StepB1_JoinLobby(ULobbyResult* PrefferedLobbyR
 
 	if (PrefferedLobbyResult && Subsystem.IsValid() && PC.IsValid())
 	{
+		NumJoinAttempts++;
+
 		auto NewDelegate
 		{
 			FLobbyJoinCompleteDelegate::CreateUObject(this, &ThisClass::StepB2_CompleteJoin)
 		};
 
-		if (Subsystem->JoinLobby(PC.Get(), CreatePreferredJoinRequest(PrefferedLobbyResult), NewDelegate))
+		CurrentJoinReq = CreatePreferredJoinRequest(PrefferedLobbyResult);
+
+		if (Subsystem->JoinLobby(PC.Get(), CurrentJoinReq, NewDelegate))
 		{
 			return;
 		}
@@ -150,7 +287,12 @@ void UAsyncAction_QuickPlayLobby::StepB2_CompleteJoin(ULobbyJoinRequest* JoinReq
 {
 	if (bPendingCancel)
 	{
-		HandleLeaveLobby();
+		// Nothing to leave if the operation was cancelled before it completed
+
+		if (Result.bWasSuccessful)
+		{
+			HandleLeaveLobby();
+		}
 		return;
 	}
 
@@ -170,12 +312,53 @@ void UAsyncAction_QuickPlayLobby::StepB2_CompleteJoin(ULobbyJoinRequest* JoinReq
 		}
 	}
 
-	// Handle failure if not successed
+	// Try the next candidate if not successed
 
 	else
 	{
-		HandleFailureWithResult(Result);
+		StepB3_JoinNextCandidate(Result);
+	}
+}
+
+void UAsyncAction_QuickPlayLobby::StepB3_JoinNextCandidate(const FOnlineServiceResult& LastResult)
+{
+	if (bPendingCancel)
+	{
+		return;
 	}
+
+	// Give up if the deadline has passed while trying candidates, report a timeout when no join has failed yet
+
+	if ((JoinDeadline > 0.0) && (FPlatformTime::Seconds() > JoinDeadline))
+	{
+		HandleFailureWithResult(LastResult.bWasSuccessful ? FOnlineServiceResult(Errors::Timeout()) : LastResult);
+		return;
+	}
+
+	// Skip candidates that failed to be joined since the search, for example by another quick play
+
+	while (!CandidateLobbies.IsEmpty() && Subsystem.IsValid() && (!CandidateLobbies[0] || Subsystem->IsLobbyBlacklisted(CandidateLobbies[0]->GetLobbyId(), true)))
+	{
+		CandidateLobbies.RemoveAt(0);
+	}
+
+	// Widen the search or create a new lobby when all candidates have been tried or the attempt limit is reached
+
+	if (CandidateLobbies.IsEmpty() || (NumJoinAttempts >= GetDefault<UOnlineDeveloperSettings>()->GetQuickPlayMaxJoinAttempts()))
+	{
+		CandidateLobbies.Reset();
+
+		if (!StepA3_WidenSearch())
+		{
+			StepC1_CreateLobby();
+		}
+		return;
+	}
+
+	auto* NextLobby{ CandidateLobbies[0].Get() };
+	CandidateLobbies.RemoveAt(0);
+
+	StepB1_JoinLobby(NextLobby);
 }
 
 ULobbyJoinRequest* UAsyncAction_QuickPlayLobby::CreatePreferredJoinRequest(ULobbyResult* PrefferedLobbyResult)
@@ -192,7 +375,7 @@ ULobbyJoinRequest* UAsyncAction_QuickPlayLobby::CreatePreferredJoinRequest(ULobb
 
 void UAsyncAction_QuickPlayLobby::StepC1_CreateLobby()
 {
-	if (bPendingCancel)
+	if (bPendingCancel || bCompleted)
 	{
 		return;
 	}
@@ -203,6 +386,19 @@ void UAsyncAction_QuickPlayLobby::StepC1_CreateLobby()
 		return;
 	}
 
+	// Let the lobby already being created speculatively decide the result
+
+	if (bHedgedCreateInFlight)
+	{
+		bWaitingForHedgedCreate = true;
+		return;
+	}
+
+	if (auto* TimerManager{ GetTimerManager() })
+	{
+		TimerManager->ClearTimer(HedgeTimerHandle);
+	}
+
 	auto NewDelegate
 	{
 		FLobbyCreateCompleteDelegate::CreateUObject(this, &ThisClass::StepC2_CompleteCreate)
@@ -220,7 +416,12 @@ void UAsyncAction_QuickPlayLobby::StepC2_CompleteCreate(ULobbyCreateRequest* Cre
 {
 	if (bPendingCancel)
 	{
-		HandleLeaveLobby();
+		// Nothing to leave if the operation was cancelled before it completed
+
+		if (Result.bWasSuccessful)
+		{
+			HandleLeaveLobby();
+		}
 		return;
 	}
 
@@ -249,12 +450,145 @@ void UAsyncAction_QuickPlayLobby::StepC2_CompleteCreate(ULobbyCreateRequest* Cre
 }
 
 
+// [Step D] Hedge create while searching
+
+void UAsyncAction_QuickPlayLobby::StepD1_StartHedge()
+{
+	if (bPendingCancel || bCompleted || !Subsystem.IsValid() || !PC.IsValid())
+	{
+		return;
+	}
+
+	// Resolve the map and build the creation parameters while the search is still in progress
+
+	FString OutError;
+	if (!CreateReq->PrepareCreation(OutError))
+	{
+		// Creating the lobby later will fail in the same way, so leave it to the normal path
+
+		return;
+	}
+
+	if (!GetDefault<UOnlineDeveloperSettings>()->ShouldQuickPlayHedgeCreate())
+	{
+		return;
+	}
+
+	auto NewDelegate
+	{
+		FLobbyCreateCompleteDelegate::CreateUObject(this, &ThisClass::StepD2_CompleteHedgedCreate)
+	};
+
+	// Start Create speculatively
+
+	bHedgedCreateInFlight = Subsystem->CreateLobby(PC.Get(), CreateReq, NewDelegate);
+}
+
+void UAsyncAction_QuickPlayLobby::StepD2_CompleteHedgedCreate(ULobbyCreateRequest* CreateRequest, FOnlineServiceResult Result)
+{
+	bHedgedCreateInFlight = false;
+
+	// Leave the created lobby if the quick play has already ended
+
+	if (bPendingCancel || bCompleted)
+	{
+		if (Result.bWasSuccessful)
+		{
+			HandleLeaveLobby();
+		}
+		return;
+	}
+
+	// The search has found lobbies to join, so leave the created lobby before trying them
+
+	if (bAbandonHedgedCreate)
+	{
+		bAbandonHedgedCreate = false;
+
+		auto NewDelegate
+		{
+			FLobbyLeaveCompleteDelegate::CreateUObject(this, &ThisClass::StepD3_CompleteAbandonHedgedCreate)
+		};
+
+		if (!Result.bWasSuccessful)
+		{
+			StepB3_JoinNextCandidate(FOnlineServiceResult());
+		}
+
+		// Keep the created lobby if it cannot be left
+
+		else if (!Subsystem.IsValid() || !Subsystem->CleanUpLobby(CreateReq->LocalName, PC.Get(), NewDelegate))
+		{
+			StepC2_CompleteCreate(CreateRequest, Result);
+		}
+
+		return;
+	}
+
+	// The created lobby wins if it is ready before the search finds a lobby
+
+	if (Result.bWasSuccessful)
+	{
+		StepC2_CompleteCreate(CreateRequest, Result);
+	}
+
+	// Handle failure if the search has already ended, otherwise the search continues
+
+	else if (bWaitingForHedgedCreate)
+	{
+		HandleFailureWithResult(Result);
+	}
+}
+
+void UAsyncAction_QuickPlayLobby::StepD3_CompleteAbandonHedgedCreate(FOnlineServiceResult Result)
+{
+	if (bPendingCancel || bCompleted)
+	{
+		return;
+	}
+
+	// Keep the created lobby if it could not be left
+
+	if (!Result.bWasSuccessful)
+	{
+		HandleSuccess(CreateReq->Result);
+		return;
+	}
+
+	StepB3_JoinNextCandidate(FOnlineServiceResult());
+}
+
+void UAsyncAction_QuickPlayLobby::StopHedge()
+{
+	if (auto* TimerManager{ GetTimerManager() })
+	{
+		TimerManager->ClearTimer(HedgeTimerHandle);
+	}
+}
+
+
 // Success
 
 void UAsyncAction_QuickPlayLobby::HandleSuccess(ULobbyResult* LobbyResult)
 {
 	if (ensure(LobbyResult))
 	{
+		bCompleted = true;
+
+		// Stop the search that may still be running alongside the speculative creation, its completion is ignored since bCompleted is set
+
+		if (auto* TimerManager{ GetTimerManager() })
+		{
+			TimerManager->ClearTimer(WideningTimerHandle);
+		}
+
+		if (Subsystem.IsValid())
+		{
+			Subsystem->CancelLobbyOperation(CurrentSearchReq);
+		}
+
+		StopHedge();
+
 		OnComplete.Broadcast(PC.Get(), LobbyResult, FOnlineServiceResult());
 	}
 	else
@@ -268,6 +602,10 @@ void UAsyncAction_QuickPlayLobby::HandleSuccess(ULobbyResult* LobbyResult)
 
 void UAsyncAction_QuickPlayLobby::HandleFailure()
 {
+	bCompleted = true;
+
+	StopHedge();
+
 	if (ShouldBroadcastDelegates())
 	{
 		FOnlineServiceResult Result;
@@ -283,6 +621,10 @@ void UAsyncAction_QuickPlayLobby::HandleFailure()
 
 void UAsyncAction_QuickPlayLobby::HandleFailureWithResult(const FOnlineServiceResult& Result)
 {
+	bCompleted = true;
+
+	StopHedge();
+
 	if (ShouldBroadcastDelegates())
 	{
 		OnFailed.Broadcast(PC.Get(), nullptr, Result);
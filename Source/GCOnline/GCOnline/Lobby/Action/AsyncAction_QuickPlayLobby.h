@@ -46,12 +46,79 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<ULobbyCreateRequest> CreateReq;
 
+	//
+	// Request of the search in progress, a widened copy of SearchReq once widening has started
+	//
+	UPROPERTY(Transient)
+	TObjectPtr<ULobbySearchRequest> CurrentSearchReq;
+
+	//
+	// Request of the join in progress or last attempted
+	//
+	UPROPERTY(Transient)
+	TObjectPtr<ULobbyJoinRequest> CurrentJoinReq;
+
+	//
+	// Index of the widening step applied to the current search, INDEX_NONE if not widened yet
+	//
+	UPROPERTY(Transient)
+	int32 WideningStepIndex{ INDEX_NONE };
+
+	UPROPERTY(Transient)
+	double FirstSearchStartTime{ 0.0 };
+
+	UPROPERTY(Transient)
+	double SearchStartTime{ 0.0 };
+
+	FTimerHandle WideningTimerHandle;
+
 	UPROPERTY(Transient)
 	bool bCanCreateLobby{ false };
 
 	UPROPERTY(Transient)
 	bool bPendingCancel{ false };
 
+	//
+	// Lobbies found by the search that have not been tried yet, in the order they should be tried
+	//
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ULobbyResult>> CandidateLobbies;
+
+	UPROPERTY(Transient)
+	int32 NumJoinAttempts{ 0 };
+
+	//
+	// Time in seconds after which no more candidates are tried, 0 if there is no deadline
+	//
+	UPROPERTY(Transient)
+	double JoinDeadline{ 0.0 };
+
+	FTimerHandle HedgeTimerHandle;
+
+	//
+	// Whether a lobby is being created speculatively while the search is in progress
+	//
+	UPROPERTY(Transient)
+	bool bHedgedCreateInFlight{ false };
+
+	//
+	// Whether the search has found lobbies to join, so the speculatively created lobby must be left
+	//
+	UPROPERTY(Transient)
+	bool bAbandonHedgedCreate{ false };
+
+	//
+	// Whether the search has ended without a lobby to join, so the speculative creation decides the result
+	//
+	UPROPERTY(Transient)
+	bool bWaitingForHedgedCreate{ false };
+
+	//
+	// Whether the result has been decided, callbacks of the path that lost are ignored
+	//
+	UPROPERTY(Transient)
+	bool bCompleted{ false };
+
 public:
 	UPROPERTY(BlueprintAssignable)
 	FAsyncQuickPlayLobbyDelegate OnComplete;
@@ -83,7 +150,12 @@ protected:
 protected:
 	virtual void StepA1_SearchLobby();
 	virtual void StepA2_SelectLobby(ULobbySearchRequest* SearchRequest, FOnlineServiceResult Result);
-	virtual ULobbyResult* ChoosePreferredLobby(const TArray<ULobbyResult*>& Results);
+	virtual TArray<ULobbyResult*> RankCandidateLobbies(const TArray<ULobbyResult*>& Results);
+
+	/**
+	 * Schedules a search with the next widening step, returns false if there are no more steps or the deadline would be exceeded
+	 */
+	virtual bool StepA3_WidenSearch();
 
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -91,6 +163,7 @@ protected:
 protected:
 	virtual void StepB1_JoinLobby(ULobbyResult* PrefferedLobbyResult);
 	virtual void StepB2_CompleteJoin(ULobbyJoinRequest* JoinRequest, FOnlineServiceResult Result);
+	virtual void StepB3_JoinNextCandidate(const FOnlineServiceResult& LastResult);
 	virtual ULobbyJoinRequest* CreatePreferredJoinRequest(ULobbyResult* PrefferedLobbyResult);
 
 
@@ -101,6 +174,19 @@ protected:
 	virtual void StepC2_CompleteCreate(ULobbyCreateRequest* CreateRequest, FOnlineServiceResult Result);
 
 
+	//////////////////////////////////////////////////////////////////////////////
+	// [Step D] Hedge create while searching
+protected:
+	virtual void StepD1_StartHedge();
+	virtual void StepD2_CompleteHedgedCreate(ULobbyCreateRequest* CreateRequest, FOnlineServiceResult Result);
+	virtual void StepD3_CompleteAbandonHedgedCreate(FOnlineServiceResult Result);
+
+	/**
+	 * Stops hedging and discards the creation prepared in advance
+	 */
+	void StopHedge();
+
+
 	//////////////////////////////////////////////////////////////////////////////
 	// Success
 protected:
@@ -37,6 +37,18 @@ void UAsyncAction_SearchLobby::Activate()
 	HandleFailure();
 }
 
+void UAsyncAction_SearchLobby::Cancel()
+{
+	Super::Cancel();
+
+	// Stop the search in progress, its completion is no longer broadcast
+
+	if (Subsystem.IsValid())
+	{
+		Subsystem->CancelLobbyOperation(Request.Get());
+	}
+}
+
 void UAsyncAction_SearchLobby::HandleFailure()
 {
 	if (ShouldBroadcastDelegates())
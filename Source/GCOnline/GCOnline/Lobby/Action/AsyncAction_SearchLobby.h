@@ -51,6 +51,7 @@ public:
 
 protected:
 	virtual void Activate() override;
+	virtual void Cancel() override;
 
 	virtual void HandleFailure();
 	virtual void HandleSearchLobbyComplete(ULobbySearchRequest* SearchRequest, FOnlineServiceResult Result);
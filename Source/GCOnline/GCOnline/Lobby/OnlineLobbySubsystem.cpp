@@ -4,6 +4,8 @@
 
 #include "Type/OnlineLobbyResultTypes.h"
 #include "OnlineServiceSubsystem.h"
+#include "OnlineLocalUserSubsystem.h"
+#include "OnlineLocalUserManagerSubsystem.h"
 #include "OnlineDeveloperSettings.h"
 #include "GCOnlineLogs.h"
 
@@ -11,6 +13,13 @@
 #include "Online/OnlineResult.h"
 #include "Online/OnlineServices.h"
 #include "Online/OnlineServicesEngineUtils.h"
+#include "Online/OnlineSessionNames.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/Base64.h"
+#include "Misc/PackageName.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(OnlineLobbySubsystem)
 
@@ -24,6 +33,8 @@ void UOnlineLobbySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	check(OnlineServiceSubsystem);
 
 	BindLobbiesDelegates();
+
+	PostLoadMapDelegateHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
 }
 
 void UOnlineLobbySubsystem::Deinitialize()
@@ -31,6 +42,58 @@ void UOnlineLobbySubsystem::Deinitialize()
 	OnlineServiceSubsystem = nullptr;
 
 	UnbindLobbiesDelegates();
+
+	ClearLobbySearchCache();
+
+	// Queued modifications will never be sent
+
+	for (auto& KVP : LobbyAttributeModifyQueues)
+	{
+		for (const auto& Delegate : KVP.Value.Delegates)
+		{
+			Delegate.ExecuteIfBound(KVP.Value.LobbyResult.Get(), FOnlineServiceResult(Errors::Cancelled()));
+		}
+	}
+
+	LobbyAttributeModifyQueues.Empty();
+	LobbyAttributeFlushesInFlight.Empty();
+
+	LobbyRosters.Empty();
+	LobbyAttributeSnapshots.Empty();
+	PendingRosterDeltas.Empty();
+	PendingLobbyEvents = FPendingLobbyEvents();
+	LobbyHistory.Empty();
+	LobbyBlacklist.Empty();
+	LocalUserLobbyMembers.Empty();
+	LocalUsersLobbyBatches.Empty();
+	AbortedOperations.Empty();
+
+	ResetStagedInvite();
+	RejectedInviteJoinRequests.Empty();
+
+	if (auto* GameInstance{ GetGameInstance() })
+	{
+		GameInstance->GetTimerManager().ClearTimer(DeadlineWheelTimerHandle);
+	}
+
+	for (auto& Slot : DeadlineWheel)
+	{
+		Slot.Empty();
+	}
+
+	NumDeadlineEntries = 0;
+
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapDelegateHandle);
+
+	TArray<FName> PreloadNames;
+	LobbyMapPreloads.GenerateKeyArray(PreloadNames);
+
+	for (const auto& LocalName : PreloadNames)
+	{
+		ReleaseLobbyMapPreload(LocalName);
+	}
+
+	HandlePostLoadMap(nullptr);
 }
 
 bool UOnlineLobbySubsystem::ShouldCreateSubsystem(UObject* Outer) const
@@ -46,12 +109,21 @@ bool UOnlineLobbySubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 void UOnlineLobbySubsystem::BindLobbiesDelegates()
 {
-	if (auto LobbiesInterface{ GetLobbiesInterface() })
+	// Lobbies can be joined in any context, so events are received from all of them
+
+	for (const auto& Context : GetAvailableServiceContexts())
 	{
-		LobbyDelegateHandles.Emplace(LobbiesInterface->OnUILobbyJoinRequested().Add(this, &ThisClass::HandleUserJoinLobbyRequest));
-		LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyMemberJoined().Add(this, &ThisClass::HandleLobbyMemberJoined));
-		LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyMemberLeft().Add(this, &ThisClass::HandleLobbyMemberLeft));
-		LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyLeaderChanged().Add(this, &ThisClass::HandleLobbyLeaderChanged));
+		if (auto LobbiesInterface{ GetLobbiesInterface(Context) })
+		{
+			LobbyDelegateHandles.Emplace(LobbiesInterface->OnUILobbyJoinRequested().Add(this, &ThisClass::HandleUserJoinLobbyRequest, Context));
+			LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyJoined().Add(this, &ThisClass::HandleLobbyJoined));
+			LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyLeft().Add(this, &ThisClass::HandleLobbyLeft));
+			LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyMemberJoined().Add(this, &ThisClass::HandleLobbyMemberJoined));
+			LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyMemberLeft().Add(this, &ThisClass::HandleLobbyMemberLeft));
+			LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyAttributesChanged().Add(this, &ThisClass::HandleLobbyAttributesChanged));
+			LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyMemberAttributesChanged().Add(this, &ThisClass::HandleLobbyMemberAttributesChanged));
+			LobbyDelegateHandles.Emplace(LobbiesInterface->OnLobbyLeaderChanged().Add(this, &ThisClass::HandleLobbyLeaderChanged));
+		}
 	}
 }
 
@@ -72,24 +144,79 @@ ILobbiesPtr UOnlineLobbySubsystem::GetLobbiesInterface(EOnlineServiceContext Con
 		return nullptr;
 	}
 
-	auto OnlineService{ OnlineServiceSubsystem->GetContextCache() };
+	// The platform context may not exist, so only the default context is expected to be valid
 
-	if (ensure(OnlineService))
+	auto OnlineService{ OnlineServiceSubsystem->GetContextCache(Context) };
+
+	if (OnlineService)
 	{
 		return OnlineService->GetLobbiesInterface();
 	}
 
+	ensure(Context != EOnlineServiceContext::Default);
+
 	return nullptr;
 }
 
+TArray<EOnlineServiceContext> UOnlineLobbySubsystem::GetAvailableServiceContexts() const
+{
+	TArray<EOnlineServiceContext> Contexts;
+
+	if (OnlineServiceSubsystem->GetContextCache(EOnlineServiceContext::Default))
+	{
+		Contexts.Emplace(EOnlineServiceContext::Default);
+	}
+
+	if (OnlineServiceSubsystem->HasSeparatePlatformContext())
+	{
+		Contexts.Emplace(EOnlineServiceContext::Platform);
+	}
+
+	return Contexts;
+}
+
+FAccountId UOnlineLobbySubsystem::GetLocalAccountId(const ULocalPlayer* LocalPlayer, EOnlineServiceContext Context) const
+{
+	if (!LocalPlayer)
+	{
+		return FAccountId();
+	}
+
+	if (OnlineServiceSubsystem->ResolveOnlineServiceContext(Context) == EOnlineServiceContext::Default)
+	{
+		return LocalPlayer->GetPreferredUniqueNetId().GetV2();
+	}
+
+	const auto* LocalUser{ ULocalPlayer::GetSubsystem<UOnlineLocalUserSubsystem>(LocalPlayer) };
+
+	return LocalUser ? LocalUser->GetNetId(Context).GetV2() : FAccountId();
+}
+
+bool UOnlineLobbySubsystem::ValidateLobbyContext(const ULocalPlayer* LocalPlayer, EOnlineServiceContext Context, FString& OutError) const
+{
+	if (!GetLobbiesInterface(Context))
+	{
+		OutError = FString::Printf(TEXT("No online service for context (%s)"), *StaticEnum<EOnlineServiceContext>()->GetNameStringByValue(static_cast<int64>(Context)));
+		return false;
+	}
+
+	if (!GetLocalAccountId(LocalPlayer, Context).IsValid())
+	{
+		OutError = FString::Printf(TEXT("LocalPlayer(%s) has no account on context (%s)"), *GetNameSafe(LocalPlayer), *StaticEnum<EOnlineServiceContext>()->GetNameStringByValue(static_cast<int64>(Context)));
+		return false;
+	}
+
+	return true;
+}
+
 
 // Lobby Events
 
-void UOnlineLobbySubsystem::HandleUserJoinLobbyRequest(const FUILobbyJoinRequested& EventParams)
+void UOnlineLobbySubsystem::HandleUserJoinLobbyRequest(const FUILobbyJoinRequested& EventParams, EOnlineServiceContext Context)
 {
 	check(OnlineServiceSubsystem);
 
-	auto OnlineService{ OnlineServiceSubsystem->GetContextCache() };
+	auto OnlineService{ OnlineServiceSubsystem->GetContextCache(Context) };
 	check(OnlineService);
 
 	auto AuthInterface{ OnlineService->GetAuthInterface() };
@@ -107,6 +234,11 @@ void UOnlineLobbySubsystem::HandleUserJoinLobbyRequest(const FUILobbyJoinRequest
 		{
 			RequestedLobbyResult = NewObject<ULobbyResult>(this);
 			RequestedLobbyResult->InitializeResult(EventParams.Result.GetOkValue());
+			RequestedLobbyResult->SetServiceContext(Context);
+
+			// Start joining before the game has accepted the invite, so accepting it does not have to wait
+
+			StartSpeculativeInviteJoin(PlatformUserId, RequestedLobbyResult);
 		}
 		else
 		{
@@ -121,8 +253,59 @@ void UOnlineLobbySubsystem::HandleUserJoinLobbyRequest(const FUILobbyJoinRequest
 	}
 }
 
+void UOnlineLobbySubsystem::HandleLobbyJoined(const FLobbyJoined& EventParams)
+{
+	// Rebuild the roster in case it was left over from a previous lobby with the same name
+
+	LobbyRosters.Remove(EventParams.Lobby->LocalName);
+
+	FindOrAddLobbyRoster(*EventParams.Lobby);
+
+	LobbyAttributeSnapshots.Emplace(EventParams.Lobby->LocalName, EventParams.Lobby->Attributes);
+}
+
+void UOnlineLobbySubsystem::HandleLobbyLeft(const FLobbyLeft& EventParams)
+{
+	const auto LocalName{ EventParams.Lobby->LocalName };
+
+	// The roster and snapshot are shared by all local users in the lobby, so keep them until the last of them leaves
+
+	if (LocalUserLobbyMembers.Contains(LocalName))
+	{
+		return;
+	}
+
+	for (const auto& KVP : EventParams.Lobby->Members)
+	{
+		if (KVP.Value->bIsLocalMember)
+		{
+			return;
+		}
+	}
+
+	LobbyAttributeSnapshots.Remove(LocalName);
+
+	FLobbyRoster Roster;
+	if (LobbyRosters.RemoveAndCopyValue(LocalName, Roster))
+	{
+		auto& Delta{ GetPendingRosterDelta(LocalName) };
+
+		for (const auto& KVP : Roster.GetMembers())
+		{
+			Delta.MarkRemoved(KVP.Key);
+		}
+	}
+}
+
 void UOnlineLobbySubsystem::HandleLobbyMemberJoined(const FLobbyMemberJoined& EventParams)
 {
+	auto& Roster{ FindOrAddLobbyRoster(*EventParams.Lobby) };
+
+	if (Roster.AddOrUpdate(EventParams.Member))
+	{
+		GetPendingRosterDelta(EventParams.Lobby->LocalName).MarkAdded(EventParams.Member->AccountId);
+	}
+
 	if (!EventParams.Member->bIsLocalMember)
 	{
 		const auto LocalName{ EventParams.Lobby->LocalName };
@@ -136,12 +319,88 @@ void UOnlineLobbySubsystem::HandleLobbyMemberJoined(const FLobbyMemberJoined& Ev
 void UOnlineLobbySubsystem::HandleLobbyMemberLeft(const FLobbyMemberLeft& EventParams)
 {
 	const auto LocalName{ EventParams.Lobby->LocalName };
+
+	if (auto* Roster{ LobbyRosters.Find(LocalName) })
+	{
+		if (Roster->Remove(EventParams.Member->AccountId))
+		{
+			GetPendingRosterDelta(LocalName).MarkRemoved(EventParams.Member->AccountId);
+		}
+	}
+
 	const auto CurrentMembers{ EventParams.Lobby->Members.Num() };
 	const auto MaxMembers{ EventParams.Lobby->MaxMembers };
 
 	NotifyLobbyMemberChanged(LocalName, CurrentMembers, MaxMembers);
 }
 
+void UOnlineLobbySubsystem::HandleLobbyAttributesChanged(const FLobbyAttributesChanged& EventParams)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	check(DevSettings);
+
+	const auto LocalName{ EventParams.Lobby->LocalName };
+
+	auto& Snapshot{ LobbyAttributeSnapshots.FindOrAdd(LocalName) };
+
+	FLobbyAttributeChanges Changes{ LocalName };
+	Changes.Diff(Snapshot, EventParams.Lobby->Attributes, [DevSettings](const FName& InName) { return DevSettings->RedirectLobbyAttribute_ToProject(InName); });
+
+	Snapshot = EventParams.Lobby->Attributes;
+
+	if (!Changes.IsEmpty())
+	{
+		// Start joining the handed off lobby before the change is notified, so the join does not wait for the next frame
+
+		const auto& HandoffAttributeName{ DevSettings->GetLobbyHandoffAttributeName() };
+
+		if (Changes.AddedAttributes.Contains(HandoffAttributeName) || Changes.ChangedAttributes.Contains(HandoffAttributeName))
+		{
+			HandleLobbyHandoff(*EventParams.Lobby);
+		}
+
+		NotifyLobbyAttributesChanged(Changes);
+	}
+}
+
+void UOnlineLobbySubsystem::HandleLobbyMemberAttributesChanged(const FLobbyMemberAttributesChanged& EventParams)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	check(DevSettings);
+
+	const auto LocalName{ EventParams.Lobby->LocalName };
+
+	auto& Roster{ FindOrAddLobbyRoster(*EventParams.Lobby) };
+
+	// Compare with the attributes of the member at the last update
+
+	FLobbyAttributeChanges Changes{ LocalName };
+	Changes.MemberId = FUniqueNetIdRepl(EventParams.Member->AccountId);
+
+	static const TMap<FSchemaAttributeId, FSchemaVariant> EmptyAttributes;
+	const auto* Entry{ Roster.Find(EventParams.Member->AccountId) };
+
+	Changes.Diff(Entry ? Entry->GetAttributes() : EmptyAttributes, EventParams.Member->Attributes, [DevSettings](const FName& InName) { return DevSettings->RedirectUserLobbyAttribute_ToProject(InName); });
+
+	const auto bAdded{ Roster.AddOrUpdate(EventParams.Member) };
+
+	auto& Delta{ GetPendingRosterDelta(EventParams.Lobby->LocalName) };
+
+	if (bAdded)
+	{
+		Delta.MarkAdded(EventParams.Member->AccountId);
+	}
+	else
+	{
+		Delta.MarkChanged(EventParams.Member->AccountId);
+	}
+
+	if (!Changes.IsEmpty())
+	{
+		NotifyLobbyMemberAttributesChanged(Changes);
+	}
+}
+
 void UOnlineLobbySubsystem::HandleLobbyLeaderChanged(const FLobbyLeaderChanged& EventParams)
 {
 	const auto LocalName{ EventParams.Lobby->LocalName };
@@ -157,13 +416,195 @@ void UOnlineLobbySubsystem::HandleLobbyLeaderChanged(const FLobbyLeaderChanged&
 	const auto* World{ GetWorld() };
 	const auto* Player{ World->GetFirstLocalPlayerFromController() };
 
-	if (Player && Player->GetPreferredUniqueNetId().GetV2() == EventParams.Leader->AccountId)
+	const auto* LobbyResult{ GetJoinedLobby(LocalName) };
+	const auto Context{ LobbyResult ? LobbyResult->GetServiceContext() : EOnlineServiceContext::Default };
+
+	if (Player && GetLocalAccountId(Player, Context) == EventParams.Leader->AccountId)
 	{
 		NotifyLobbyBecomeLeader(LocalName);
 	}
 }
 
 
+// Ongoing Operations
+
+FLobbyOperationKey UOnlineLobbySubsystem::BeginOperation(FName LocalName, ELobbyOperationType Type, UObject* Request)
+{
+	check(Request);
+
+	const FLobbyOperationKey NewKey{ LocalName, ++LastOperationId };
+
+	OngoingOperations.Emplace(NewKey, FLobbyOperation(Type, Request));
+
+	return NewKey;
+}
+
+void UOnlineLobbySubsystem::EndOperation(const FLobbyOperationKey& Key)
+{
+	OngoingOperations.Remove(Key);
+}
+
+bool UOnlineLobbySubsystem::HasOngoingOperation(FName LocalName, ELobbyOperationType Type) const
+{
+	for (const auto& KVP : OngoingOperations)
+	{
+		if ((KVP.Key.LocalName == LocalName) && (KVP.Value.Type == Type))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UOnlineLobbySubsystem::AbortOperation(const FLobbyOperationKey& Key, const FOnlineError& Error)
+{
+	auto* Operation{ OngoingOperations.Find(Key) };
+	if (!Operation || !Operation->Abort)
+	{
+		return false;
+	}
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Abort Lobby Operation"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), Key.OperationId);
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *Key.LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), *Error.GetLogString());
+
+	// The online service may still complete a create or join that is aborted, its lobby is left when it does
+
+	if ((Operation->Type == ELobbyOperationType::Create) || (Operation->Type == ELobbyOperationType::Join))
+	{
+		AbortedOperations.Emplace(Key);
+	}
+
+	// The completion handler removes the operation, so take the function out of it first
+
+	auto Abort{ MoveTemp(Operation->Abort) };
+	Abort(Error);
+
+	return true;
+}
+
+bool UOnlineLobbySubsystem::CancelLobbyOperation(UObject* Request)
+{
+	if (!Request)
+	{
+		return false;
+	}
+
+	// Local users batches run one operation per local user with the same request
+
+	TArray<FLobbyOperationKey, TInlineAllocator<4>> KeysToAbort;
+
+	for (const auto& KVP : OngoingOperations)
+	{
+		if (KVP.Value.Request == Request)
+		{
+			KeysToAbort.Emplace(KVP.Key);
+		}
+	}
+
+	if (!KeysToAbort.IsEmpty())
+	{
+		auto bAborted{ false };
+
+		for (const auto& Key : KeysToAbort)
+		{
+			bAborted |= AbortOperation(Key, Errors::Cancelled());
+		}
+
+		return bAborted;
+	}
+
+	for (auto& KVP : OngoingOperations)
+	{
+		// Detach the caller from the search it was attached to, the search continues for the others
+
+		const auto FollowerIndex{ KVP.Value.SearchFollowers.IndexOfByPredicate([Request](const FLobbySearchFollower& Follower) { return Follower.Request == Request; }) };
+
+		if (FollowerIndex != INDEX_NONE)
+		{
+			const auto Follower{ KVP.Value.SearchFollowers[FollowerIndex] };
+			KVP.Value.SearchFollowers.RemoveAt(FollowerIndex);
+
+			Follower.Delegate.ExecuteIfBound(Follower.Request, FOnlineServiceResult(Errors::Cancelled()));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UOnlineLobbySubsystem::ScheduleOperationDeadline(const FLobbyOperationKey& Key, FLobbyOperation& Operation)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	check(DevSettings);
+
+	const auto Timeout{ DevSettings->GetLobbyOperationTimeout(Operation.Type) };
+	auto* GameInstance{ GetGameInstance() };
+
+	if ((Timeout <= 0.0f) || !GameInstance)
+	{
+		return;
+	}
+
+	const auto Resolution{ DevSettings->GetLobbyOperationDeadlineResolution() };
+
+	Operation.Deadline = FPlatformTime::Seconds() + Timeout;
+
+	// Round up so that the operation never expires before its timeout
+
+	const auto ExpiryTick{ DeadlineWheelTick + FMath::Max<int64>(FMath::CeilToInt64(Timeout / Resolution), 1) };
+
+	DeadlineWheel[ExpiryTick % DeadlineWheelSize].Add({ Key, ExpiryTick });
+	++NumDeadlineEntries;
+
+	// One timer drives the deadlines of all operations
+
+	auto& TimerManager{ GameInstance->GetTimerManager() };
+
+	if (!TimerManager.IsTimerActive(DeadlineWheelTimerHandle))
+	{
+		TimerManager.SetTimer(DeadlineWheelTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::HandleDeadlineWheelTick), Resolution, true);
+	}
+}
+
+void UOnlineLobbySubsystem::HandleDeadlineWheelTick()
+{
+	++DeadlineWheelTick;
+
+	auto& Slot{ DeadlineWheel[DeadlineWheelTick % DeadlineWheelSize] };
+
+	TArray<FLobbyOperationKey, TInlineAllocator<4>> ExpiredKeys;
+
+	for (auto Index{ Slot.Num() - 1 }; Index >= 0; --Index)
+	{
+		if (Slot[Index].ExpiryTick <= DeadlineWheelTick)
+		{
+			ExpiredKeys.Emplace(Slot[Index].Key);
+
+			Slot.RemoveAtSwap(Index);
+			--NumDeadlineEntries;
+		}
+	}
+
+	// Aborting may start new operations that add to the wheel, so do it after the slot has been updated
+
+	for (const auto& Key : ExpiredKeys)
+	{
+		AbortOperation(Key, Errors::Timeout());
+	}
+
+	if (NumDeadlineEntries <= 0)
+	{
+		if (auto* GameInstance{ GetGameInstance() })
+		{
+			GameInstance->GetTimerManager().ClearTimer(DeadlineWheelTimerHandle);
+		}
+	}
+}
+
+
 // Create Lobby
 
 ULobbyCreateRequest* UOnlineLobbySubsystem::CreateOnlineLobbyCreateRequest()
@@ -182,9 +623,9 @@ bool UOnlineLobbySubsystem::CreateLobby(APlayerController* HostingPlayer, ULobby
 		return false;
 	}
 
-	if (OngoingCreateRequest)
+	if (HasOngoingOperation(CreateRequest->LocalName, ELobbyOperationType::Create) || HasOngoingOperation(CreateRequest->LocalName, ELobbyOperationType::Join))
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Create Lobby failed: A request already in progress exists."));
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Create Lobby failed: A request already in progress exists (LocalName: %s)."), *CreateRequest->LocalName.ToString());
 		return false;
 	}
 
@@ -202,15 +643,20 @@ bool UOnlineLobbySubsystem::CreateLobby(APlayerController* HostingPlayer, ULobby
 		return false;
 	}
 
+	if (LocalPlayer ? !ValidateLobbyContext(LocalPlayer, EOnlineServiceContext::Default, OutError) : !GetLobbiesInterface())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Create Lobby failed: %s"), LocalPlayer ? *OutError : TEXT("No online service"));
+		return false;
+	}
+
 	CreateOnlineLobbyInternal(LocalPlayer, CreateRequest, Delegate);
 	return true;
 }
 
-void UOnlineLobbySubsystem::CreateOnlineLobbyInternal(ULocalPlayer* LocalPlayer, ULobbyCreateRequest* CreateRequest, FLobbyCreateCompleteDelegate Delegate)
+void UOnlineLobbySubsystem::CreateOnlineLobbyInternal(ULocalPlayer* LocalPlayer, ULobbyCreateRequest* CreateRequest, FLobbyCreateCompleteDelegate Delegate, bool bBroadcastComplete)
 {
 	check(CreateRequest);
 	ensure(Delegate.IsBound());
-	ensure(!OngoingCreateRequest);
 
 	auto LobbiesInterface{ GetLobbiesInterface() };
 	check(LobbiesInterface);
@@ -228,31 +674,61 @@ void UOnlineLobbySubsystem::CreateOnlineLobbyInternal(ULocalPlayer* LocalPlayer,
 		/// @TODO what should this do for v2?
 	}
 
-	///@ TODO: Add splitscreen players
+	// Other local users join once the lobby has been created (see CreateLobbyForLocalUsers)
 
 	// Set ongoing request
 
-	OngoingCreateRequest = CreateRequest;
+	const auto OperationKey{ BeginOperation(CreateRequest->LocalName, ELobbyOperationType::Create, CreateRequest) };
+	OngoingOperations.FindChecked(OperationKey).bBroadcastComplete = bBroadcastComplete;
+
+	// Load the map while the lobby is being created
+
+	StartLobbyMapPreload(CreateRequest->LocalName, CreateRequest->GetMapName());
 
 	// Start Create Lobby
 
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Create New Lobby"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *OperationKey.LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
+
+	const auto CreatingAccountId{ CreateParams.LocalAccountId };
 
 	auto Handle{ LobbiesInterface->CreateLobby(MoveTemp(CreateParams)) };
-	Handle.OnComplete(this, &ThisClass::HandleCreateOnlineLobbyComplete, Delegate);
-}
+	Handle.OnComplete(this, &ThisClass::HandleCreateOnlineLobbyComplete, OperationKey, CreatingAccountId, Delegate);
 
-void UOnlineLobbySubsystem::HandleCreateOnlineLobbyComplete(const TOnlineResult<FCreateLobby>& CreateResult, FLobbyCreateCompleteDelegate Delegate)
+	ArmOperation<FCreateLobby>(OperationKey, Handle, [this, OperationKey, CreatingAccountId, Delegate](const TOnlineResult<FCreateLobby>& Result)
+	{
+		HandleCreateOnlineLobbyComplete(Result, OperationKey, CreatingAccountId, Delegate);
+	});
+}
+
+void UOnlineLobbySubsystem::HandleCreateOnlineLobbyComplete(const TOnlineResult<FCreateLobby>& CreateResult, FLobbyOperationKey OperationKey, FAccountId CreatingAccountId, FLobbyCreateCompleteDelegate Delegate)
 {
-	if (!ensure(OngoingCreateRequest))
+	// The request may have been discarded by CleanUpLobby or aborted while it was in progress
+
+	auto* CreateRequest{ GetOperationRequest<ULobbyCreateRequest>(OperationKey) };
+	if (!CreateRequest)
 	{
+		if (AbortedOperations.Remove(OperationKey) && CreateResult.IsOk() && CreateResult.GetOkValue().Lobby && CreatingAccountId.IsValid())
+		{
+			UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Create Lobby Completed after abort: Leave Lobby"));
+			UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
+
+			LeaveLobbyForLocalUsers(CreateResult.GetOkValue().Lobby->LobbyId, EOnlineServiceContext::Default, { CreatingAccountId });
+		}
+
 		return;
 	}
 
+	const auto bBroadcastComplete{ OngoingOperations.FindChecked(OperationKey).bBroadcastComplete };
+
+	EndOperation(OperationKey);
+
 	const auto bSuccess{ CreateResult.IsOk() };
 	const auto NewLobby{ bSuccess ? CreateResult.GetOkValue().Lobby : nullptr };
 
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Create Lobby Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *CreateResult.GetErrorValue().GetLogString());
 	
@@ -265,28 +741,40 @@ void UOnlineLobbySubsystem::HandleCreateOnlineLobbyComplete(const TOnlineResult<
 
 		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(NewLobby ? NewLobby->LobbyId : FLobbyId()));
 
-		const auto TravelURL{ OngoingCreateRequest->ConstructTravelURL() };
+		const auto TravelURL{ CreateRequest->ConstructTravelURL() };
 		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| URL: %s"), *TravelURL);
 
 		NewResult->SetLobbyTravelURL(TravelURL);
 		AddJoiningLobby(NewResult);
 
-		OngoingCreateRequest->Result = NewResult;
+		CreateRequest->Result = NewResult;
 	}
 	else
 	{
 		ServiceResult = FOnlineServiceResult(CreateResult.GetErrorValue());
 
-		OngoingCreateRequest->Result = nullptr;
+		CreateRequest->Result = nullptr;
+
+		ReleaseLobbyMapPreload(OperationKey.LocalName);
 	}
 
 	ensure(Delegate.IsBound());
-	Delegate.ExecuteIfBound(OngoingCreateRequest, ServiceResult);
+	Delegate.ExecuteIfBound(CreateRequest, ServiceResult);
+
+	if (bBroadcastComplete)
+	{
+		BroadcastLobbyCreateComplete(CreateRequest, ServiceResult);
+	}
+}
 
-	K2_OnLobbyCreateComplete.Broadcast(OngoingCreateRequest, ServiceResult);
-	OnLobbyCreateComplete.Broadcast(OngoingCreateRequest, ServiceResult);
+void UOnlineLobbySubsystem::BroadcastLobbyCreateComplete(ULobbyCreateRequest* CreateRequest, const FOnlineServiceResult& Result)
+{
+	if (K2_OnLobbyCreateComplete.IsBound())
+	{
+		K2_OnLobbyCreateComplete.Broadcast(CreateRequest, Result);
+	}
 
-	OngoingCreateRequest = nullptr;
+	OnLobbyCreateComplete.Broadcast(CreateRequest, Result);
 }
 
 
@@ -306,16 +794,23 @@ bool UOnlineLobbySubsystem::SearchLobby(APlayerController* SearchingPlayer, ULob
 		return false;
 	}
 
-	if (OngoingSearchRequest)
+	auto* LocalPlayer{ SearchingPlayer ? SearchingPlayer->GetLocalPlayer() : nullptr };
+	if (!LocalPlayer)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Search Lobby failed: A request already in progress exists."));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Search Lobby Failed: HostingPlayer is invalid."));
 		return false;
 	}
 
-	auto* LocalPlayer{ SearchingPlayer ? SearchingPlayer->GetLocalPlayer() : nullptr };
-	if (!LocalPlayer)
+	FString OutError;
+	if (!SearchRequest->ValidateAndLogErrors(OutError))
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Search Lobby Failed: HostingPlayer is invalid."));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Search Lobby Failed: %s"), *OutError);
+		return false;
+	}
+
+	if (!ValidateLobbyContext(LocalPlayer, SearchRequest->ServiceContext, OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Search Lobby Failed: %s"), *OutError);
 		return false;
 	}
 
@@ -328,647 +823,3193 @@ void UOnlineLobbySubsystem::SearchOnlineLobbyInternal(ULocalPlayer* LocalPlayer,
 	check(LocalPlayer);
 	check(SearchRequest);
 	ensure(Delegate.IsBound());
-	ensure(!OngoingSearchRequest);
 
-	auto LobbiesInterface{ GetLobbiesInterface() };
+	const auto CanonicalHash{ SearchRequest->GetCanonicalHash() };
+
+	// Return recent results of an equivalent search if available
+
+	if (TrySearchFromCache(LocalPlayer, SearchRequest, CanonicalHash, Delegate))
+	{
+		return;
+	}
+
+	StartSearchOnlineLobby(LocalPlayer, SearchRequest, CanonicalHash, Delegate);
+}
+
+void UOnlineLobbySubsystem::StartSearchOnlineLobby(ULocalPlayer* LocalPlayer, ULobbySearchRequest* SearchRequest, uint32 CanonicalHash, FLobbySearchCompleteDelegate Delegate)
+{
+	check(LocalPlayer);
+	check(SearchRequest);
+
+	auto LobbiesInterface{ GetLobbiesInterface(SearchRequest->ServiceContext) };
 	check(LobbiesInterface);
 
+	// Attach to the search already in progress if it has equivalent parameters
+
+	const auto SearchHash{ GetSearchCoalescingHash(LocalPlayer, CanonicalHash) };
+	const auto SearchKey{ SearchRequest->GetCanonicalKey() };
+	const auto SearchAccountId{ GetLocalAccountId(LocalPlayer, SearchRequest->ServiceContext) };
+
+	if (auto* CoalescableSearch{ FindCoalescableSearch(SearchHash, SearchKey, SearchAccountId) })
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Attach to Search Lobbies in progress"));
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| SearchHash: %u"), SearchHash);
+
+		CoalescableSearch->SearchFollowers.Emplace(SearchRequest, Delegate);
+		return;
+	}
+
 	// Set Ongoing request
 
-	OngoingSearchRequest = SearchRequest;
+	const auto OperationKey{ BeginOperation(NAME_None, ELobbyOperationType::Search, SearchRequest) };
+
+	auto& Operation{ OngoingOperations.FindChecked(OperationKey) };
+	Operation.SearchHash = SearchHash;
+	Operation.SearchKey = SearchKey;
+	Operation.SearchAccountId = SearchAccountId;
 
 	// Make lobby search parameters
 
 	auto FindLobbyParams{ SearchRequest->GenerateFindParameters() };
-	FindLobbyParams.LocalAccountId = LocalPlayer->GetPreferredUniqueNetId().GetV2();
+	FindLobbyParams.LocalAccountId = SearchAccountId;
 
 	// Start lobby search
 
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Search Lobbies"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| SearchHash: %u"), SearchHash);
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Context: %s"), *StaticEnum<EOnlineServiceContext>()->GetNameStringByValue(static_cast<int64>(SearchRequest->ServiceContext)));
 
 	auto Handle{ LobbiesInterface->FindLobbies(MoveTemp(FindLobbyParams)) };
-	Handle.OnComplete(this, &ThisClass::HandleSearchOnlineLobbyComplete, Delegate);
+	Handle.OnComplete(this, &ThisClass::HandleSearchOnlineLobbyComplete, OperationKey, Delegate);
+
+	ArmOperation<FFindLobbies>(OperationKey, Handle, [this, OperationKey, Delegate](const TOnlineResult<FFindLobbies>& Result)
+	{
+		HandleSearchOnlineLobbyComplete(Result, OperationKey, Delegate);
+	});
 }
 
-void UOnlineLobbySubsystem::HandleSearchOnlineLobbyComplete(const TOnlineResult<FFindLobbies>& SearchResult, FLobbySearchCompleteDelegate Delegate)
+void UOnlineLobbySubsystem::HandleSearchOnlineLobbyComplete(const TOnlineResult<FFindLobbies>& SearchResult, FLobbyOperationKey OperationKey, FLobbySearchCompleteDelegate Delegate)
 {
-	if (!ensure(OngoingSearchRequest))
+	// The request may have been discarded by CleanUpLobby while it was in progress
+
+	auto* SearchRequest{ GetOperationRequest<ULobbySearchRequest>(OperationKey) };
+	if (!SearchRequest)
 	{
 		return;
 	}
 
+	auto& Operation{ OngoingOperations.FindChecked(OperationKey) };
+	const auto SearchHash{ Operation.SearchHash };
+	const auto SearchKey{ Operation.SearchKey };
+	const auto SearchAccountId{ Operation.SearchAccountId };
+	const auto Followers{ MoveTemp(Operation.SearchFollowers) };
+
+	EndOperation(OperationKey);
+
 	const auto bSuccess{ SearchResult.IsOk() };
 	const auto NewLobbies{ bSuccess ? SearchResult.GetOkValue().Lobbies : TArray<TSharedRef<const FLobby>>() };
 	
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Search Lobby Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *SearchResult.GetErrorValue().GetLogString());
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumLobbies: %d"), NewLobbies.Num());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumFollowers: %d"), Followers.Num());
+
+	for (const auto& Lobby : NewLobbies)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| +Lobby: %s"), *ToLogString(Lobby->LobbyId));
+	}
 
 	FOnlineServiceResult ServiceResult;
 
 	if (bSuccess)
 	{
-		for (const auto& Lobby : NewLobbies)
-		{
-			UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| +Lobby: %s"), *ToLogString(Lobby->LobbyId));
-
-			auto* NewResult{ NewObject<ULobbyResult>(this) };
-			NewResult->InitializeResult(Lobby);
-
-			OngoingSearchRequest->Results.Emplace(NewResult);
-		}
+		StoreSearchResultCache(SearchHash, SearchKey, SearchAccountId, NewLobbies);
 	}
 	else
 	{
-		OngoingSearchRequest->Results.Reset();
-
 		ServiceResult = FOnlineServiceResult(SearchResult.GetErrorValue());
 	}
 
-	ensure(Delegate.IsBound());
-	Delegate.ExecuteIfBound(OngoingSearchRequest, ServiceResult);
-
-	OngoingSearchRequest = nullptr;
-}
-
+	// Notify the request that started the search
 
-// Join Lobby
+	ApplySearchResults(SearchRequest, NewLobbies);
 
-const ULobbyResult* UOnlineLobbySubsystem::GetJoinedLobby(FName LocalName) const
-{
-	return JoiningLobbies.FindRef(LocalName);
-}
+	Delegate.ExecuteIfBound(SearchRequest, ServiceResult);
 
-void UOnlineLobbySubsystem::AddJoiningLobby(ULobbyResult* InLobbyResult)
-{
-	check(InLobbyResult);
+	// Fan out the same result to every caller attached while the search was in progress
 
-	const auto& LocalName{ InLobbyResult->GetLocalName() };
-	ensure(!JoiningLobbies.Contains(LocalName));
+	for (const auto& Follower : Followers)
+	{
+		if (Follower.Request)
+		{
+			ApplySearchResults(Follower.Request, NewLobbies);
+		}
 
-	JoiningLobbies.Emplace(LocalName, InLobbyResult);
+		Follower.Delegate.ExecuteIfBound(Follower.Request, ServiceResult);
+	}
 }
 
-void UOnlineLobbySubsystem::RemoveJoiningLobby(ULobbyResult* InLobbyResult)
+FLobbyOperation* UOnlineLobbySubsystem::FindCoalescableSearch(uint32 SearchHash, const FString& SearchKey, const FAccountId& SearchAccountId)
 {
-	if (ensure(InLobbyResult))
+	for (auto& KVP : OngoingOperations)
 	{
-		RemoveJoiningLobby(InLobbyResult->GetLocalName());
+		const auto& Operation{ KVP.Value };
+
+		if ((Operation.Type == ELobbyOperationType::Search)
+			&& (Operation.SearchHash == SearchHash)
+			&& (Operation.SearchAccountId == SearchAccountId)
+			&& Operation.SearchKey.Equals(SearchKey, ESearchCase::CaseSensitive))
+		{
+			return &KVP.Value;
+		}
 	}
+
+	return nullptr;
 }
 
-void UOnlineLobbySubsystem::RemoveJoiningLobby(FName LobbyLocalName)
+uint32 UOnlineLobbySubsystem::GetSearchCoalescingHash(const ULocalPlayer* LocalPlayer, uint32 CanonicalHash) const
 {
-	JoiningLobbies.Remove(LobbyLocalName);
-}
+	check(LocalPlayer);
 
+	// Results may differ for each local user, so only searches from the same user are coalesced
 
-ULobbyJoinRequest* UOnlineLobbySubsystem::CreateOnlineLobbyJoinRequest(ULobbyResult* LobbyResult)
-{
-	auto* NewRequest{ NewObject<ULobbyJoinRequest>(this) };
-	NewRequest->LobbyToJoin = LobbyResult;
-	return NewRequest;
+	return HashCombine(CanonicalHash, GetTypeHash(LocalPlayer->GetPreferredUniqueNetId().GetV2()));
 }
 
-bool UOnlineLobbySubsystem::JoinLobby(APlayerController* JoiningPlayer, ULobbyJoinRequest* JoinRequest, FLobbyJoinCompleteDelegate Delegate)
+void UOnlineLobbySubsystem::ApplySearchResults(ULobbySearchRequest* SearchRequest, const TArray<TSharedRef<const FLobby>>& InLobbies)
 {
-	if (!JoinRequest)
-	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby Failed: Invalid Join Request"));
-		return false;
-	}
+	check(SearchRequest);
 
-	auto LobbyToJoin{ JoinRequest->LobbyToJoin };
-	if (!LobbyToJoin)
-	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby Failed: Invalid Lobby Result"));
-		return false;
-	}
+	// Exclude lobbies that recently failed to be joined
 
-	auto Lobby{ LobbyToJoin->GetLobbyId() };
-	if (!Lobby.IsValid())
-	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby failed: Invalid LobbyId"));
-		return false;
-	}
+	TArray<TSharedRef<const FLobby>> AllowedLobbies;
+	const auto bFilterBlacklist{ SearchRequest->bExcludeBlacklistedLobbies && !LobbyBlacklist.IsEmpty() };
 
-	if (JoiningLobbies.Contains(JoinRequest->LocalName))
+	if (bFilterBlacklist)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby failed: Already Joined (LocalName: %s)"), *JoinRequest->LocalName.ToString());
-		return false;
-	}
+		AllowedLobbies.Reserve(InLobbies.Num());
 
-	auto* LocalPlayer{ JoiningPlayer ? JoiningPlayer->GetLocalPlayer() : nullptr };
-	if (!LocalPlayer)
-	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby Failed: JoiningPlayer is invalid."));
-		return false;
+		for (const auto& Lobby : InLobbies)
+		{
+			if (!IsLobbyBlacklisted(Lobby->LobbyId, true))
+			{
+				AllowedLobbies.Emplace(Lobby);
+			}
+		}
 	}
 
-	JoinOnlineLobbyInternal(LocalPlayer, JoinRequest, Delegate);
-	return true;
-}
+	const auto& Lobbies{ bFilterBlacklist ? AllowedLobbies : InLobbies };
 
-void UOnlineLobbySubsystem::JoinOnlineLobbyInternal(ULocalPlayer* LocalPlayer, ULobbyJoinRequest* JoinRequest, FLobbyJoinCompleteDelegate Delegate)
-{
-	check(LocalPlayer);
-	check(JoinRequest);
-	ensure(Delegate.IsBound());
-	ensure(!OngoingJoinRequest);
+	SearchRequest->AddedResults.Reset();
+	SearchRequest->RemovedResults.Reset();
+	SearchRequest->ChangedResults.Reset();
 
-	auto LobbiesInterface{ GetLobbiesInterface() };
-	check(LobbiesInterface);
+	// Build lightweight views for native code, attribute names are only resolved when a view is read
 
-	// Set Ongoing request
+	SearchRequest->ResultViews.Reset(Lobbies.Num());
 
-	OngoingJoinRequest = JoinRequest;
+	for (const auto& Lobby : Lobbies)
+	{
+		SearchRequest->ResultViews.Emplace(Lobby);
+	}
 
-	// Make lobby search parameters
+	SearchRequest->ResultContexts.Init(SearchRequest->ServiceContext, Lobbies.Num());
 
-	auto JoinParams{ JoinRequest->GenerateJoinParameters() };
-	JoinParams.LocalAccountId = LocalPlayer->GetPreferredUniqueNetId().GetV2();
+	if (!SearchRequest->bCreateResultObjects)
+	{
+		SearchRequest->Results.Reset();
+		return;
+	}
 
-	// Start lobby search
+	// Rebuild all results
 
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Join Lobby"));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *JoinParams.LocalName.ToString());
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(JoinParams.LocalAccountId));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(JoinParams.LobbyId));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Presence: %s"), JoinParams.bPresenceEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
+	if (!SearchRequest->bIncrementalRefresh)
+	{
+		SearchRequest->Results.Reset(Lobbies.Num());
 
-	auto Handle{ LobbiesInterface->JoinLobby(MoveTemp(JoinParams)) };
-	Handle.OnComplete(this, &ThisClass::HandleJoinOnlineLobbyComplete, JoinParams.LocalAccountId, Delegate);
-}
+		for (const auto& Lobby : Lobbies)
+		{
+			auto* NewResult{ NewObject<ULobbyResult>(this) };
+			NewResult->InitializeResult(Lobby);
+			NewResult->SetServiceContext(SearchRequest->ServiceContext);
+
+			SearchRequest->Results.Emplace(NewResult);
+		}
 
-void UOnlineLobbySubsystem::HandleJoinOnlineLobbyComplete(const TOnlineResult<FJoinLobby>& JoinResult, FAccountId JoiningAccountId, FLobbyJoinCompleteDelegate Delegate)
-{
-	if (!ensure(OngoingJoinRequest) || !ensure(JoiningAccountId.IsValid()))
-	{
 		return;
 	}
 
-	const auto bSuccess{ JoinResult.IsOk() };
-	const auto NewLobby{ bSuccess ? JoinResult.GetOkValue().Lobby : nullptr };
-	
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Join Lobby Completed"));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *JoinResult.GetErrorValue().GetLogString());
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(NewLobby ? NewLobby->LobbyId : FLobbyId()));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OwnerId: %s"), *ToLogString(NewLobby ? NewLobby->OwnerAccountId : FAccountId()));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| MyId: %s"), *ToLogString(JoiningAccountId));
+	// Index the results of the previous search by lobby id
 
-	FOnlineServiceResult ServiceResult;
+	TMap<FLobbyId, TObjectPtr<ULobbyResult>> PreviousResults;
+	PreviousResults.Reserve(SearchRequest->Results.Num());
 
-	if (bSuccess)
+	for (const auto& Result : SearchRequest->Results)
 	{
-		if (!ensure(OngoingJoinRequest->LobbyToJoin))
+		if (Result && Result->GetLobby())
 		{
-			OngoingJoinRequest->LobbyToJoin = NewObject<ULobbyResult>(this);
+			PreviousResults.Emplace(Result->GetLobbyId(), Result);
 		}
-		OngoingJoinRequest->LobbyToJoin->InitializeResult(NewLobby);
+	}
 
-		const auto TravelURL{ ConstructJoiningLobbyTravelURL(JoiningAccountId, NewLobby->LobbyId) };
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| URL: %s"), *TravelURL);
+	// Reuse the result objects of lobbies that are still found
 
-		if (TravelURL.IsEmpty() || !NewLobby.IsValid())
+	SearchRequest->Results.Reset(Lobbies.Num());
+
+	for (const auto& Lobby : Lobbies)
+	{
+		TObjectPtr<ULobbyResult> ExistingResult;
+		if (PreviousResults.RemoveAndCopyValue(Lobby->LobbyId, ExistingResult))
 		{
-			ServiceResult.bWasSuccessful = false;
+			if (ExistingResult->HasLobbyStateChanged(*Lobby))
+			{
+				SearchRequest->ChangedResults.Emplace(ExistingResult);
+			}
+
+			ExistingResult->InitializeResult(Lobby);
+			ExistingResult->SetServiceContext(SearchRequest->ServiceContext);
+
+			SearchRequest->Results.Emplace(ExistingResult);
 		}
 		else
 		{
-			OngoingJoinRequest->LobbyToJoin->SetLobbyTravelURL(TravelURL);
+			auto* NewResult{ NewObject<ULobbyResult>(this) };
+			NewResult->InitializeResult(Lobby);
+			NewResult->SetServiceContext(SearchRequest->ServiceContext);
 
-			AddJoiningLobby(OngoingJoinRequest->LobbyToJoin);
+			SearchRequest->AddedResults.Emplace(NewResult);
+			SearchRequest->Results.Emplace(NewResult);
 		}
 	}
-	else
-	{
-		ServiceResult = FOnlineServiceResult(JoinResult.GetErrorValue());
-	}
-
-	ensure(Delegate.IsBound());
-	Delegate.ExecuteIfBound(OngoingJoinRequest, ServiceResult);
 
-	K2_OnLobbyJoinComplete.Broadcast(OngoingJoinRequest, ServiceResult);
-	OnLobbyJoinComplete.Broadcast(OngoingJoinRequest, ServiceResult);
+	// Remaining results are no longer found
 
-	OngoingJoinRequest = nullptr;
+	PreviousResults.GenerateValueArray(SearchRequest->RemovedResults);
 }
 
-FString UOnlineLobbySubsystem::ConstructJoiningLobbyTravelURL(const FAccountId& AccountId, const FLobbyId& LobbyId)
+
+void UOnlineLobbySubsystem::ClearLobbySearchCache()
 {
-	check(AccountId.IsValid());
-	check(LobbyId.IsValid());
+	SearchResultCache.Reset();
+	SearchResultCacheSize = 0;
+}
 
-	auto OnlineServices{ OnlineServiceSubsystem ? OnlineServiceSubsystem->GetContextCache() : nullptr };
-	check(OnlineServices);
+bool UOnlineLobbySubsystem::TrySearchFromCache(ULocalPlayer* LocalPlayer, ULobbySearchRequest* SearchRequest, uint32 CanonicalHash, FLobbySearchCompleteDelegate Delegate)
+{
+	check(SearchRequest);
 
-	FString URL;
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
 
-	auto Result{ OnlineServices->GetResolvedConnectString({ AccountId, LobbyId }) };
-	if (ensure(Result.IsOk()))
+	if (!DevSettings->IsLobbySearchCacheEnabled() || !SearchRequest->bUseCachedResults)
 	{
-		URL = Result.GetOkValue().ResolvedConnectString;
+		return false;
 	}
 
-	return URL;
-}
-
+	// Results may differ for each local user, so entries are keyed the same way as coalesced searches
 
-// Clean Up Lobby
+	const auto SearchHash{ GetSearchCoalescingHash(LocalPlayer, CanonicalHash) };
 
-bool UOnlineLobbySubsystem::CleanUpLobby(FName LocalName, const APlayerController* InPlayerController, FLobbyLeaveCompleteDelegate Delegate)
-{
-	if (!OnlineServiceSubsystem->IsOnlineServiceReady())
+	auto* Entry{ SearchResultCache.Find(SearchHash) };
+	if (!Entry)
 	{
 		return false;
 	}
 
-	CleanUpOngoingRequest();
+	// The key is only a hash, so an entry of a different search is treated as a miss and replaced once this search completes
 
-	auto* PlayerController{ InPlayerController ? InPlayerController : GetGameInstance()->GetFirstLocalPlayerController() };
-	auto* LocalPlayer{ PlayerController ? PlayerController->GetLocalPlayer() : nullptr };
-	auto LocalAccountId{ LocalPlayer ? LocalPlayer->GetPreferredUniqueNetId().GetV2() : FAccountId() };
+	if ((Entry->SearchAccountId != GetLocalAccountId(LocalPlayer, SearchRequest->ServiceContext)) || !Entry->SearchKey.Equals(SearchRequest->GetCanonicalKey(), ESearchCase::CaseSensitive))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Search Lobbies cache collision (SearchHash: %u)"), SearchHash);
+		return false;
+	}
 
-	const auto* LobbyResult{ GetJoinedLobby(LocalName) };
-	auto Lobby{ LobbyResult ? LobbyResult->GetLobby() : nullptr };
-	auto LobbyId{ Lobby ? Lobby->LobbyId : FLobbyId() };
+	const auto Now{ FPlatformTime::Seconds() };
+	const auto Age{ Now - Entry->CachedTime };
+	const auto FreshTime{ DevSettings->GetLobbySearchCacheFreshTime() };
+	const auto StaleTime{ DevSettings->GetLobbySearchCacheStaleTime() };
+
+	// Too old to be served
 
-	if (LocalAccountId.IsValid() && LobbyId.IsValid())
+	if (Age > FreshTime + StaleTime)
 	{
-		CleanUpLobbyInternal(LocalName, LocalAccountId, LobbyId, Delegate);
-		return true;
+		RemoveSearchResultCache(SearchHash);
+		return false;
 	}
-	else
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Search Lobbies served from cache"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| SearchHash: %u"), SearchHash);
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Age: %.2fs"), Age);
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumLobbies: %d"), Entry->Lobbies.Num());
+
+	Entry->LastAccessTime = Now;
+
+	ApplySearchResults(SearchRequest, Entry->Lobbies);
+
+	// Outdated results are served as is and refreshed in the background for the next search
+
+	if (Age > FreshTime)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("CleanUpLobby failed"));
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("| LocalAccountId: %s"), *ToLogString(LocalAccountId));
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+		auto* RefreshRequest{ SearchRequest->CreateWidenedRequest(INDEX_NONE, this) };
+		RefreshRequest->bUseCachedResults = false;
 
-		return false;
-	}
-}
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Refresh in background"));
 
-void UOnlineLobbySubsystem::CleanUpLobbyInternal(FName LocalName, const FAccountId& LocalAccountId, const FLobbyId& LobbyId, FLobbyLeaveCompleteDelegate Delegate)
-{
-	check(LocalName.IsValid());
-	check(LocalAccountId.IsValid());
-	check(LobbyId.IsValid());
-	ensure(Delegate.IsBound());
+		StartSearchOnlineLobby(LocalPlayer, RefreshRequest, CanonicalHash, FLobbySearchCompleteDelegate());
+	}
 
-	auto LobbiesInterface{ GetLobbiesInterface() };
-	check(LobbiesInterface);
+	// Notify on next tick so that the caller always receives the result asynchronously
 
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("CleanUpLobby: Leave Lobby"));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalAccountId: %s"), *ToLogString(LocalAccountId));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+	auto& TimerManager{ GetGameInstance()->GetTimerManager() };
+	TimerManager.SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::HandleSearchServedFromCache, TWeakObjectPtr<ULobbySearchRequest>(SearchRequest), Delegate));
 
-	FLeaveLobby::Params Param;
-	Param.LobbyId = LobbyId;
-	Param.LocalAccountId = LocalAccountId;
+	return true;
+}
 
-	auto Handle{ LobbiesInterface->LeaveLobby(MoveTemp(Param)) };
-	Handle.OnComplete(this, &ThisClass::HandleLeaveLobbyComplete, LocalName, Delegate);
+void UOnlineLobbySubsystem::HandleSearchServedFromCache(TWeakObjectPtr<ULobbySearchRequest> SearchRequest, FLobbySearchCompleteDelegate Delegate)
+{
+	Delegate.ExecuteIfBound(SearchRequest.Get(), FOnlineServiceResult());
 }
 
-void UOnlineLobbySubsystem::HandleLeaveLobbyComplete(const TOnlineResult<FLeaveLobby>& LeaveResult, FName LocalName, FLobbyLeaveCompleteDelegate Delegate)
+void UOnlineLobbySubsystem::StoreSearchResultCache(uint32 SearchHash, const FString& SearchKey, const FAccountId& SearchAccountId, const TArray<TSharedRef<const FLobby>>& Lobbies)
 {
-	const auto bSuccess{ LeaveResult.IsOk() };
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	if (!DevSettings->IsLobbySearchCacheEnabled())
+	{
+		return;
+	}
+
+	RemoveSearchResultCache(SearchHash);
+
+	auto& NewEntry{ SearchResultCache.Emplace(SearchHash) };
+	NewEntry.Lobbies = Lobbies;
+	NewEntry.CachedTime = FPlatformTime::Seconds();
+	NewEntry.LastAccessTime = NewEntry.CachedTime;
+	NewEntry.SearchKey = SearchKey;
+	NewEntry.SearchAccountId = SearchAccountId;
+
+	for (const auto& Lobby : Lobbies)
+	{
+		NewEntry.EstimatedSize += EstimateLobbyMemorySize(*Lobby);
+	}
+
+	SearchResultCacheSize += NewEntry.EstimatedSize;
+
+	TrimSearchResultCache();
+}
+
+void UOnlineLobbySubsystem::RemoveSearchResultCache(uint32 SearchHash)
+{
+	FLobbySearchCacheEntry RemovedEntry;
+	if (SearchResultCache.RemoveAndCopyValue(SearchHash, RemovedEntry))
+	{
+		SearchResultCacheSize -= RemovedEntry.EstimatedSize;
+	}
+}
+
+void UOnlineLobbySubsystem::TrimSearchResultCache()
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	const auto Now{ FPlatformTime::Seconds() };
+	const auto MaxAge{ DevSettings->GetLobbySearchCacheFreshTime() + DevSettings->GetLobbySearchCacheStaleTime() };
+	const auto MemoryBudget{ DevSettings->GetLobbySearchCacheMemoryBudget() };
+
+	// Remove expired entries
+
+	for (auto It{ SearchResultCache.CreateIterator() }; It; ++It)
+	{
+		if (Now - It->Value.CachedTime > MaxAge)
+		{
+			SearchResultCacheSize -= It->Value.EstimatedSize;
+			It.RemoveCurrent();
+		}
+	}
+
+	// Remove least recently used entries until the memory budget is met
+
+	while ((SearchResultCacheSize > MemoryBudget) && !SearchResultCache.IsEmpty())
+	{
+		auto OldestHash{ 0u };
+		auto OldestAccessTime{ TNumericLimits<double>::Max() };
+
+		for (const auto& KVP : SearchResultCache)
+		{
+			if (KVP.Value.LastAccessTime < OldestAccessTime)
+			{
+				OldestHash = KVP.Key;
+				OldestAccessTime = KVP.Value.LastAccessTime;
+			}
+		}
+
+		RemoveSearchResultCache(OldestHash);
+	}
+}
+
+SIZE_T UOnlineLobbySubsystem::EstimateLobbyMemorySize(const FLobby& Lobby)
+{
+	// Approximation only, strings owned by attribute values are not counted
+
+	auto Size{ sizeof(FLobby) + Lobby.Attributes.GetAllocatedSize() + Lobby.Members.GetAllocatedSize() };
+
+	for (const auto& KVP : Lobby.Members)
+	{
+		Size += sizeof(FLobbyMember) + KVP.Value->Attributes.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+
+// Search Lobby Multi Context
+
+bool UOnlineLobbySubsystem::SearchLobbyInAllContexts(APlayerController* SearchingPlayer, ULobbySearchRequest* SearchRequest, FLobbySearchCompleteDelegate Delegate)
+{
+	if (!SearchRequest)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Search Lobby In All Contexts Failed: Invalid Request"));
+		return false;
+	}
+
+	auto* LocalPlayer{ SearchingPlayer ? SearchingPlayer->GetLocalPlayer() : nullptr };
+	if (!LocalPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Search Lobby In All Contexts Failed: SearchingPlayer is invalid."));
+		return false;
+	}
+
+	FString OutError;
+	if (!SearchRequest->ValidateAndLogErrors(OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Search Lobby In All Contexts Failed: %s"), *OutError);
+		return false;
+	}
+
+	const auto Contexts{ GetAvailableServiceContexts() };
+	if (Contexts.IsEmpty())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Search Lobby In All Contexts Failed: No online service available"));
+		return false;
+	}
+
+	auto State{ MakeShared<FLobbyMultiContextSearchState>() };
+	State->Request.Reset(SearchRequest);
+	State->Delegate = Delegate;
+	State->Searches.SetNum(Contexts.Num());
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Search Lobbies In All Contexts"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumContexts: %d"), Contexts.Num());
+
+	// Prepare all searches before starting any, since results served from the cache may complete early
+
+	for (auto Index{ 0 }; Index < Contexts.Num(); ++Index)
+	{
+		auto* ContextRequest{ SearchRequest->CreateWidenedRequest(INDEX_NONE, this) };
+		ContextRequest->ServiceContext = Contexts[Index];
+		ContextRequest->bIncrementalRefresh = false;
+
+		auto& Search{ State->Searches[Index] };
+		Search.Context = Contexts[Index];
+		Search.Request.Reset(ContextRequest);
+	}
+
+	auto& TimerManager{ GetGameInstance()->GetTimerManager() };
+	const auto Deadline{ SearchRequest->ContextSearchDeadline };
+
+	for (auto Index{ 0 }; Index < State->Searches.Num(); ++Index)
+	{
+		auto& Search{ State->Searches[Index] };
+
+		if (Deadline > 0.0f)
+		{
+			TimerManager.SetTimer(Search.DeadlineHandle, FTimerDelegate::CreateUObject(this, &ThisClass::HandleContextSearchDeadline, State, Index), Deadline, false);
+		}
+
+		SearchOnlineLobbyInternal(LocalPlayer, Search.Request.Get(), FLobbySearchCompleteDelegate::CreateUObject(this, &ThisClass::HandleContextSearchComplete, State, Index));
+	}
+
+	return true;
+}
+
+void UOnlineLobbySubsystem::HandleContextSearchComplete(ULobbySearchRequest* ContextRequest, FOnlineServiceResult Result, TSharedRef<FLobbyMultiContextSearchState> State, int32 SearchIndex)
+{
+	auto& Search{ State->Searches[SearchIndex] };
+
+	// Dropped by the deadline
+
+	if (State->bCompleted || Search.bCompleted)
+	{
+		return;
+	}
+
+	GetGameInstance()->GetTimerManager().ClearTimer(Search.DeadlineHandle);
+
+	Search.bCompleted = true;
+	Search.Result = Result;
+
+	TryCompleteMultiContextSearch(State);
+}
+
+void UOnlineLobbySubsystem::HandleContextSearchDeadline(TSharedRef<FLobbyMultiContextSearchState> State, int32 SearchIndex)
+{
+	auto& Search{ State->Searches[SearchIndex] };
+
+	if (State->bCompleted || Search.bCompleted)
+	{
+		return;
+	}
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Search Lobbies In Context reached the deadline (%s)"), *StaticEnum<EOnlineServiceContext>()->GetNameStringByValue(static_cast<int64>(Search.Context)));
+
+	Search.bCompleted = true;
+	Search.Result = FOnlineServiceResult(Errors::Timeout());
+
+	TryCompleteMultiContextSearch(State);
+}
+
+void UOnlineLobbySubsystem::TryCompleteMultiContextSearch(TSharedRef<FLobbyMultiContextSearchState> State)
+{
+	for (const auto& Search : State->Searches)
+	{
+		if (!Search.bCompleted)
+		{
+			return;
+		}
+	}
+
+	State->bCompleted = true;
+
+	auto* SearchRequest{ State->Request.Get() };
+	if (!SearchRequest)
+	{
+		return;
+	}
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Search Lobbies In All Contexts Completed"));
+
+	SearchRequest->Results.Reset();
+	SearchRequest->ResultViews.Reset();
+	SearchRequest->ResultContexts.Reset();
+	SearchRequest->AddedResults.Reset();
+	SearchRequest->RemovedResults.Reset();
+	SearchRequest->ChangedResults.Reset();
+
+	// Succeeds if any context succeeded, otherwise reports the error of the first context
+
+	TOptional<FOnlineServiceResult> FirstError;
+	auto bAnySucceeded{ false };
+
+	TSet<FLobbyId> FoundLobbyIds;
+
+	for (const auto& Search : State->Searches)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Context: %s, Result: %s"), 
+			*StaticEnum<EOnlineServiceContext>()->GetNameStringByValue(static_cast<int64>(Search.Context)), Search.Result.bWasSuccessful ? TEXT("Success") : TEXT("Failed"));
+
+		if (!Search.Result.bWasSuccessful)
+		{
+			if (!FirstError.IsSet())
+			{
+				FirstError = Search.Result;
+			}
+
+			continue;
+		}
+
+		bAnySucceeded = true;
+
+		const auto* ContextRequest{ Search.Request.Get() };
+
+		for (auto Index{ 0 }; Index < ContextRequest->ResultViews.Num(); ++Index)
+		{
+			const auto& View{ ContextRequest->ResultViews[Index] };
+
+			bool bAlreadyFound{ false };
+			FoundLobbyIds.Emplace(View.GetLobbyId(), &bAlreadyFound);
+
+			if (bAlreadyFound)
+			{
+				continue;
+			}
+
+			SearchRequest->ResultViews.Emplace(View);
+			SearchRequest->ResultContexts.Emplace(Search.Context);
+
+			if (ContextRequest->Results.IsValidIndex(Index))
+			{
+				SearchRequest->Results.Emplace(ContextRequest->Results[Index]);
+			}
+		}
+	}
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumLobbies: %d"), SearchRequest->ResultViews.Num());
+
+	const auto ServiceResult{ (bAnySucceeded || !FirstError.IsSet()) ? FOnlineServiceResult() : FirstError.GetValue() };
+
+	State->Delegate.ExecuteIfBound(SearchRequest, ServiceResult);
+}
+
+
+// Join Lobby
+
+const ULobbyResult* UOnlineLobbySubsystem::GetJoinedLobby(FName LocalName) const
+{
+	return JoiningLobbies.FindRef(LocalName);
+}
+
+void UOnlineLobbySubsystem::AddJoiningLobby(ULobbyResult* InLobbyResult)
+{
+	check(InLobbyResult);
+
+	const auto& LocalName{ InLobbyResult->GetLocalName() };
+	ensure(!JoiningLobbies.Contains(LocalName));
+
+	JoiningLobbies.Emplace(LocalName, InLobbyResult);
+}
+
+void UOnlineLobbySubsystem::RemoveJoiningLobby(ULobbyResult* InLobbyResult)
+{
+	if (ensure(InLobbyResult))
+	{
+		RemoveJoiningLobby(InLobbyResult->GetLocalName());
+	}
+}
+
+void UOnlineLobbySubsystem::RemoveJoiningLobby(FName LobbyLocalName)
+{
+	JoiningLobbies.Remove(LobbyLocalName);
+}
+
+
+ULobbyJoinRequest* UOnlineLobbySubsystem::CreateOnlineLobbyJoinRequest(ULobbyResult* LobbyResult)
+{
+	auto* NewRequest{ NewObject<ULobbyJoinRequest>(this) };
+	NewRequest->LobbyToJoin = LobbyResult;
+	return NewRequest;
+}
+
+bool UOnlineLobbySubsystem::JoinLobby(APlayerController* JoiningPlayer, ULobbyJoinRequest* JoinRequest, FLobbyJoinCompleteDelegate Delegate)
+{
+	if (!JoinRequest)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby Failed: Invalid Join Request"));
+		return false;
+	}
+
+	auto LobbyToJoin{ JoinRequest->LobbyToJoin };
+	if (!LobbyToJoin)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby Failed: Invalid Lobby Result"));
+		return false;
+	}
+
+	auto Lobby{ LobbyToJoin->GetLobbyId() };
+	if (!Lobby.IsValid())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby failed: Invalid LobbyId"));
+		return false;
+	}
+
+	if (JoiningLobbies.Contains(JoinRequest->LocalName))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby failed: Already Joined (LocalName: %s)"), *JoinRequest->LocalName.ToString());
+		return false;
+	}
+
+	if (HasOngoingOperation(JoinRequest->LocalName, ELobbyOperationType::Create) || HasOngoingOperation(JoinRequest->LocalName, ELobbyOperationType::Join))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Join Lobby failed: A request already in progress exists (LocalName: %s)."), *JoinRequest->LocalName.ToString());
+		return false;
+	}
+
+	auto* LocalPlayer{ JoiningPlayer ? JoiningPlayer->GetLocalPlayer() : nullptr };
+	if (!LocalPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby Failed: JoiningPlayer is invalid."));
+		return false;
+	}
+
+	FString OutError;
+	if (!ValidateLobbyContext(LocalPlayer, LobbyToJoin->GetServiceContext(), OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby Failed: %s"), *OutError);
+		return false;
+	}
+
+	JoinOnlineLobbyInternal(LocalPlayer, JoinRequest, Delegate);
+	return true;
+}
+
+void UOnlineLobbySubsystem::JoinOnlineLobbyInternal(ULocalPlayer* LocalPlayer, ULobbyJoinRequest* JoinRequest, FLobbyJoinCompleteDelegate Delegate, bool bBroadcastComplete)
+{
+	check(LocalPlayer);
+	check(JoinRequest);
+	ensure(Delegate.IsBound());
+
+	// Join in the context where the lobby was found
+
+	const auto Context{ JoinRequest->LobbyToJoin ? JoinRequest->LobbyToJoin->GetServiceContext() : EOnlineServiceContext::Default };
+
+	auto LobbiesInterface{ GetLobbiesInterface(Context) };
+	check(LobbiesInterface);
+
+	// Set Ongoing request
+
+	const auto OperationKey{ BeginOperation(JoinRequest->LocalName, ELobbyOperationType::Join, JoinRequest) };
+	OngoingOperations.FindChecked(OperationKey).bBroadcastComplete = bBroadcastComplete;
+
+	// Load the map advertised by the lobby while joining
+
+	FString MapName;
+	if (JoinRequest->LobbyToJoin && JoinRequest->LobbyToJoin->GetLobbyAttributeAsString(SETTING_MAPNAME, MapName))
+	{
+		StartLobbyMapPreload(JoinRequest->LocalName, MapName);
+	}
+
+	// Make lobby search parameters
+
+	auto JoinParams{ JoinRequest->GenerateJoinParameters() };
+	JoinParams.LocalAccountId = GetLocalAccountId(LocalPlayer, Context);
+
+	// Start lobby search
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Join Lobby"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *JoinParams.LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(JoinParams.LocalAccountId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(JoinParams.LobbyId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Presence: %s"), JoinParams.bPresenceEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
+
+	const auto JoiningAccountId{ JoinParams.LocalAccountId };
+
+	auto Handle{ LobbiesInterface->JoinLobby(MoveTemp(JoinParams)) };
+	Handle.OnComplete(this, &ThisClass::HandleJoinOnlineLobbyComplete, OperationKey, JoiningAccountId, Context, Delegate);
+
+	ArmOperation<FJoinLobby>(OperationKey, Handle, [this, OperationKey, JoiningAccountId, Context, Delegate](const TOnlineResult<FJoinLobby>& Result)
+	{
+		HandleJoinOnlineLobbyComplete(Result, OperationKey, JoiningAccountId, Context, Delegate);
+	});
+}
+
+void UOnlineLobbySubsystem::HandleJoinOnlineLobbyComplete(const TOnlineResult<FJoinLobby>& JoinResult, FLobbyOperationKey OperationKey, FAccountId JoiningAccountId, EOnlineServiceContext Context, FLobbyJoinCompleteDelegate Delegate)
+{
+	// The request may have been discarded by CleanUpLobby or aborted while it was in progress
+
+	auto* JoinRequest{ GetOperationRequest<ULobbyJoinRequest>(OperationKey) };
+	if (!JoinRequest)
+	{
+		if (AbortedOperations.Remove(OperationKey) && JoinResult.IsOk() && JoinResult.GetOkValue().Lobby)
+		{
+			UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Join Lobby Completed after abort: Leave Lobby"));
+			UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
+
+			LeaveLobbyForLocalUsers(JoinResult.GetOkValue().Lobby->LobbyId, Context, { JoiningAccountId });
+		}
+
+		return;
+	}
+
+	const auto bBroadcastComplete{ OngoingOperations.FindChecked(OperationKey).bBroadcastComplete };
+
+	EndOperation(OperationKey);
+
+	if (!ensure(JoiningAccountId.IsValid()))
+	{
+		return;
+	}
+
+	const auto bSuccess{ JoinResult.IsOk() };
+	const auto NewLobby{ bSuccess ? JoinResult.GetOkValue().Lobby : nullptr };
+	
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Join Lobby Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *JoinResult.GetErrorValue().GetLogString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(NewLobby ? NewLobby->LobbyId : FLobbyId()));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OwnerId: %s"), *ToLogString(NewLobby ? NewLobby->OwnerAccountId : FAccountId()));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| MyId: %s"), *ToLogString(JoiningAccountId));
+
+	FOnlineServiceResult ServiceResult;
+
+	if (bSuccess)
+	{
+		if (!ensure(JoinRequest->LobbyToJoin))
+		{
+			JoinRequest->LobbyToJoin = NewObject<ULobbyResult>(this);
+		}
+		JoinRequest->LobbyToJoin->InitializeResult(NewLobby);
+
+		const auto TravelURL{ ConstructJoiningLobbyTravelURL(JoiningAccountId, NewLobby->LobbyId, JoinRequest->LobbyToJoin->GetServiceContext()) };
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| URL: %s"), *TravelURL);
+
+		if (TravelURL.IsEmpty() || !NewLobby.IsValid())
+		{
+			ServiceResult.bWasSuccessful = false;
+
+			ReleaseLobbyMapPreload(OperationKey.LocalName);
+		}
+		else
+		{
+			JoinRequest->LobbyToJoin->SetLobbyTravelURL(TravelURL);
+
+			AddJoiningLobby(JoinRequest->LobbyToJoin);
+
+			// Reload if the map has changed since the lobby was found
+
+			FString MapName;
+			if (JoinRequest->LobbyToJoin->GetLobbyAttributeAsString(SETTING_MAPNAME, MapName))
+			{
+				StartLobbyMapPreload(OperationKey.LocalName, MapName);
+			}
+		}
+	}
+	else
+	{
+		ServiceResult = FOnlineServiceResult(JoinResult.GetErrorValue());
+
+		ReleaseLobbyMapPreload(OperationKey.LocalName);
+
+		// Cancelled and timed out joins say nothing about the lobby itself
+
+		const auto& Error{ JoinResult.GetErrorValue() };
+
+		if (JoinRequest->LobbyToJoin && (Error != Errors::Cancelled()) && (Error != Errors::Timeout()))
+		{
+			const auto Reason{ ClassifyLobbyJoinFailure(JoinResult.GetErrorValue(), JoinRequest->LobbyToJoin) };
+
+			UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Reason: %s"), *StaticEnum<ELobbyJoinFailureReason>()->GetNameStringByValue(static_cast<int64>(Reason)));
+
+			ReportLobbyJoinFailure(JoinRequest->LobbyToJoin->GetLobbyId(), Reason);
+		}
+	}
+
+	ensure(Delegate.IsBound());
+	Delegate.ExecuteIfBound(JoinRequest, ServiceResult);
+
+	if (bBroadcastComplete)
+	{
+		BroadcastLobbyJoinComplete(JoinRequest, ServiceResult);
+	}
+}
+
+void UOnlineLobbySubsystem::BroadcastLobbyJoinComplete(ULobbyJoinRequest* JoinRequest, const FOnlineServiceResult& Result)
+{
+	if (K2_OnLobbyJoinComplete.IsBound())
+	{
+		K2_OnLobbyJoinComplete.Broadcast(JoinRequest, Result);
+	}
+
+	OnLobbyJoinComplete.Broadcast(JoinRequest, Result);
+}
+
+FString UOnlineLobbySubsystem::ConstructJoiningLobbyTravelURL(const FAccountId& AccountId, const FLobbyId& LobbyId, EOnlineServiceContext Context)
+{
+	check(AccountId.IsValid());
+	check(LobbyId.IsValid());
+
+	auto OnlineServices{ OnlineServiceSubsystem ? OnlineServiceSubsystem->GetContextCache(Context) : nullptr };
+	check(OnlineServices);
+
+	FString URL;
+
+	auto Result{ OnlineServices->GetResolvedConnectString({ AccountId, LobbyId }) };
+	if (ensure(Result.IsOk()))
+	{
+		URL = Result.GetOkValue().ResolvedConnectString;
+	}
+
+	return URL;
+}
+
+
+// Local Users Lobby
+
+bool UOnlineLobbySubsystem::CreateLobbyForLocalUsers(ULobbyCreateRequest* CreateRequest, FLobbyCreateCompleteDelegate Delegate)
+{
+	if (!CreateRequest)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Create Lobby For Local Users failed: passed an invalid request."));
+		return false;
+	}
+
+	if (JoiningLobbies.Contains(CreateRequest->LocalName) || HasOngoingOperation(CreateRequest->LocalName, ELobbyOperationType::Create) || HasOngoingOperation(CreateRequest->LocalName, ELobbyOperationType::Join))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Create Lobby For Local Users failed: A lobby or request already exists (LocalName: %s)."), *CreateRequest->LocalName.ToString());
+		return false;
+	}
+
+	FString OutError;
+	if (!CreateRequest->ValidateAndLogErrors(OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Create Lobby For Local Users failed: %s"), *OutError);
+		return false;
+	}
+
+	auto Batch{ MakeShared<FLocalUsersLobbyBatch>() };
+
+	auto* PrimaryPlayer{ GetLocalUsersForLobby(Batch->Context, Batch->MemberAccountIds) };
+	if (!PrimaryPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Create Lobby For Local Users failed: No initialized local user or invalid account id."));
+		return false;
+	}
+
+	if (!ValidateLobbyContext(PrimaryPlayer, Batch->Context, OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Create Lobby For Local Users failed: %s"), *OutError);
+		return false;
+	}
+
+	if (Batch->MemberAccountIds.Num() >= CreateRequest->GetMaxPlayers())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Create Lobby For Local Users failed: %d local users do not fit in %d slots."), Batch->MemberAccountIds.Num() + 1, CreateRequest->GetMaxPlayers());
+		return false;
+	}
+
+	Batch->LocalName = CreateRequest->LocalName;
+	Batch->PrimaryAccountId = GetLocalAccountId(PrimaryPlayer, Batch->Context);
+	Batch->bPresenceEnabled = CreateRequest->bPresenceEnabled;
+	Batch->CreateRequest = CreateRequest;
+	Batch->CreateDelegate = Delegate;
+	Batch->NumPending = 1;
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Create Lobby For Local Users"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *Batch->LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumLocalUsers: %d"), Batch->MemberAccountIds.Num() + 1);
+
+	LocalUsersLobbyBatches.Emplace(Batch->LocalName, Batch);
+
+	CreateOnlineLobbyInternal(PrimaryPlayer, CreateRequest, FLobbyCreateCompleteDelegate::CreateUObject(this, &ThisClass::HandleLocalUsersCreateComplete, Batch), false);
+	return true;
+}
+
+bool UOnlineLobbySubsystem::JoinLobbyForLocalUsers(ULobbyJoinRequest* JoinRequest, FLobbyJoinCompleteDelegate Delegate)
+{
+	if (!JoinRequest)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby For Local Users Failed: Invalid Join Request"));
+		return false;
+	}
+
+	auto LobbyToJoin{ JoinRequest->LobbyToJoin };
+	if (!LobbyToJoin || !LobbyToJoin->GetLobbyId().IsValid())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby For Local Users Failed: Invalid Lobby Result"));
+		return false;
+	}
+
+	if (JoiningLobbies.Contains(JoinRequest->LocalName) || HasOngoingOperation(JoinRequest->LocalName, ELobbyOperationType::Create) || HasOngoingOperation(JoinRequest->LocalName, ELobbyOperationType::Join))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Join Lobby For Local Users failed: A lobby or request already exists (LocalName: %s)."), *JoinRequest->LocalName.ToString());
+		return false;
+	}
+
+	TArray<FAccountId> MemberAccountIds;
+
+	auto* PrimaryPlayer{ GetLocalUsersForLobby(LobbyToJoin->GetServiceContext(), MemberAccountIds) };
+	if (!PrimaryPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby For Local Users Failed: No initialized local user or invalid account id."));
+		return false;
+	}
+
+	return JoinLobbyForLocalUsersInternal(PrimaryPlayer, MoveTemp(MemberAccountIds), JoinRequest, Delegate);
+}
+
+bool UOnlineLobbySubsystem::JoinLobbyForLocalUsersInternal(ULocalPlayer* PrimaryPlayer, TArray<FAccountId> MemberAccountIds, ULobbyJoinRequest* JoinRequest, FLobbyJoinCompleteDelegate Delegate)
+{
+	check(PrimaryPlayer);
+	check(JoinRequest);
+
+	auto LobbyToJoin{ JoinRequest->LobbyToJoin };
+	check(LobbyToJoin);
+
+	auto Batch{ MakeShared<FLocalUsersLobbyBatch>() };
+	Batch->Context = LobbyToJoin->GetServiceContext();
+	Batch->MemberAccountIds = MoveTemp(MemberAccountIds);
+
+	FString OutError;
+	if (!ValidateLobbyContext(PrimaryPlayer, Batch->Context, OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby For Local Users Failed: %s"), *OutError);
+		return false;
+	}
+
+	// Fail early instead of rolling back a join that cannot succeed, lobbies decoded from a handoff do not know their capacity
+
+	if ((LobbyToJoin->GetMaxMembers() > 0) && (Batch->MemberAccountIds.Num() >= LobbyToJoin->GetNumOpenSlot()))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Join Lobby For Local Users Failed: %d local users do not fit in %d open slots."), Batch->MemberAccountIds.Num() + 1, LobbyToJoin->GetNumOpenSlot());
+		return false;
+	}
+
+	Batch->LocalName = JoinRequest->LocalName;
+	Batch->LobbyId = LobbyToJoin->GetLobbyId();
+	Batch->PrimaryAccountId = GetLocalAccountId(PrimaryPlayer, Batch->Context);
+	Batch->bPresenceEnabled = JoinRequest->bPresenceEnabled;
+	Batch->JoinRequest = JoinRequest;
+	Batch->JoinDelegate = Delegate;
+	Batch->NumPending = 1;
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Join Lobby For Local Users"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *Batch->LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(Batch->LobbyId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumLocalUsers: %d"), Batch->MemberAccountIds.Num() + 1);
+
+	// The primary user and all members join at the same time
+
+	LocalUsersLobbyBatches.Emplace(Batch->LocalName, Batch);
+
+	JoinOnlineLobbyInternal(PrimaryPlayer, JoinRequest, FLobbyJoinCompleteDelegate::CreateUObject(this, &ThisClass::HandleLocalUsersPrimaryJoinComplete, Batch), false);
+
+	StartLocalUsersMemberJoin(Batch);
+	return true;
+}
+
+ULocalPlayer* UOnlineLobbySubsystem::GetLocalUsersForLobby(EOnlineServiceContext Context, TArray<FAccountId>& OutMemberAccountIds) const
+{
+	OutMemberAccountIds.Reset();
+
+	const auto* LocalUserManager{ UGameInstance::GetSubsystem<UOnlineLocalUserManagerSubsystem>(GetGameInstance()) };
+	if (!LocalUserManager)
+	{
+		return nullptr;
+	}
+
+	const auto LocalUsers{ LocalUserManager->GetInitializedLocalUsers() };
+	if (LocalUsers.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	auto* PrimaryPlayer{ LocalUsers[0]->GetLocalPlayer<ULocalPlayer>() };
+	if (!GetLocalAccountId(PrimaryPlayer, Context).IsValid())
+	{
+		return nullptr;
+	}
+
+	for (auto Index{ 1 }; Index < LocalUsers.Num(); ++Index)
+	{
+		const auto AccountId{ GetLocalAccountId(LocalUsers[Index]->GetLocalPlayer<ULocalPlayer>(), Context) };
+		if (!AccountId.IsValid())
+		{
+			return nullptr;
+		}
+
+		OutMemberAccountIds.Emplace(AccountId);
+	}
+
+	return PrimaryPlayer;
+}
+
+void UOnlineLobbySubsystem::HandleLocalUsersCreateComplete(ULobbyCreateRequest* CreateRequest, FOnlineServiceResult Result, TSharedRef<FLocalUsersLobbyBatch> Batch)
+{
+	if (Batch->bCompleted)
+	{
+		return;
+	}
+
+	--Batch->NumPending;
+
+	if (!Result.bWasSuccessful || !CreateRequest->Result)
+	{
+		Batch->Result = Result;
+		TryCompleteLocalUsersBatch(Batch);
+		return;
+	}
+
+	Batch->bPrimaryJoined = true;
+	Batch->LobbyId = CreateRequest->Result->GetLobbyId();
+
+	// Members can only join once the lobby exists
+
+	StartLocalUsersMemberJoin(Batch);
+
+	TryCompleteLocalUsersBatch(Batch);
+}
+
+void UOnlineLobbySubsystem::HandleLocalUsersPrimaryJoinComplete(ULobbyJoinRequest* JoinRequest, FOnlineServiceResult Result, TSharedRef<FLocalUsersLobbyBatch> Batch)
+{
+	if (Batch->bCompleted)
+	{
+		return;
+	}
+
+	--Batch->NumPending;
+
+	if (Result.bWasSuccessful)
+	{
+		Batch->bPrimaryJoined = true;
+	}
+	else if (Batch->Result.bWasSuccessful)
+	{
+		Batch->Result = Result;
+	}
+
+	TryCompleteLocalUsersBatch(Batch);
+}
+
+void UOnlineLobbySubsystem::StartLocalUsersMemberJoin(TSharedRef<FLocalUsersLobbyBatch> Batch)
+{
+	if (Batch->MemberAccountIds.IsEmpty())
+	{
+		return;
+	}
+
+	// Member joins are registered with the request of the batch, so they can be cancelled and time out like the primary operation
+
+	auto LobbiesInterface{ GetLobbiesInterface(Batch->Context) };
+	UObject* Request{ Batch->CreateRequest.IsValid() ? static_cast<UObject*>(Batch->CreateRequest.Get()) : Batch->JoinRequest.Get() };
+
+	if (!LobbiesInterface || !Request)
+	{
+		if (Batch->Result.bWasSuccessful)
+		{
+			Batch->Result = FOnlineServiceResult(Errors::InvalidState());
+		}
+
+		return;
+	}
+
+	Batch->NumPending += Batch->MemberAccountIds.Num();
+
+	for (const auto& MemberAccountId : Batch->MemberAccountIds)
+	{
+		const auto OperationKey{ BeginOperation(Batch->LocalName, ELobbyOperationType::Join, Request) };
+		OngoingOperations.FindChecked(OperationKey).bBroadcastComplete = false;
+
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Join Lobby For Local User"));
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(MemberAccountId));
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(Batch->LobbyId));
+
+		// Only the primary user shows the lobby in presence
+
+		FJoinLobby::Params Params;
+		Params.LocalAccountId = MemberAccountId;
+		Params.LocalName = Batch->LocalName;
+		Params.LobbyId = Batch->LobbyId;
+		Params.bPresenceEnabled = false;
+
+		auto Handle{ LobbiesInterface->JoinLobby(MoveTemp(Params)) };
+		Handle.OnComplete(this, &ThisClass::HandleLocalUsersMemberJoinComplete, OperationKey, Batch, MemberAccountId);
+
+		ArmOperation<FJoinLobby>(OperationKey, Handle, [this, OperationKey, Batch, MemberAccountId](const TOnlineResult<FJoinLobby>& Result)
+		{
+			HandleLocalUsersMemberJoinComplete(Result, OperationKey, Batch, MemberAccountId);
+		});
+	}
+}
+
+void UOnlineLobbySubsystem::HandleLocalUsersMemberJoinComplete(const TOnlineResult<FJoinLobby>& JoinResult, FLobbyOperationKey OperationKey, TSharedRef<FLocalUsersLobbyBatch> Batch, FAccountId MemberAccountId)
+{
+	const auto bSuccess{ JoinResult.IsOk() };
+
+	// The join has already been aborted or discarded by CleanUpLobby, leave the lobby if it still succeeded
+
+	if (!OngoingOperations.Contains(OperationKey))
+	{
+		AbortedOperations.Remove(OperationKey);
+
+		if (bSuccess && JoinResult.GetOkValue().Lobby)
+		{
+			LeaveLobbyForLocalUsers(JoinResult.GetOkValue().Lobby->LobbyId, Batch->Context, { MemberAccountId });
+		}
+
+		return;
+	}
+
+	EndOperation(OperationKey);
+
+	if (Batch->bCompleted)
+	{
+		if (bSuccess)
+		{
+			LeaveLobbyForLocalUsers(Batch->LobbyId, Batch->Context, { MemberAccountId });
+		}
+
+		return;
+	}
+
+	--Batch->NumPending;
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Join Lobby For Local User Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| OperationId: %d"), OperationKey.OperationId);
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(MemberAccountId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *JoinResult.GetErrorValue().GetLogString());
+
+	if (bSuccess)
+	{
+		Batch->JoinedMemberAccountIds.Emplace(MemberAccountId);
+	}
+	else if (Batch->Result.bWasSuccessful)
+	{
+		Batch->Result = FOnlineServiceResult(JoinResult.GetErrorValue());
+	}
+
+	TryCompleteLocalUsersBatch(Batch);
+}
+
+void UOnlineLobbySubsystem::TryCompleteLocalUsersBatch(TSharedRef<FLocalUsersLobbyBatch> Batch)
+{
+	if (Batch->bCompleted || (Batch->NumPending > 0))
+	{
+		return;
+	}
+
+	Batch->bCompleted = true;
+
+	const auto* RegisteredBatch{ LocalUsersLobbyBatches.Find(Batch->LocalName) };
+	if (RegisteredBatch && (*RegisteredBatch == Batch))
+	{
+		LocalUsersLobbyBatches.Remove(Batch->LocalName);
+	}
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Lobby For Local Users Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *Batch->LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), Batch->Result.bWasSuccessful ? TEXT("Success") : TEXT("Failed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumJoinedMembers: %d/%d"), Batch->JoinedMemberAccountIds.Num(), Batch->MemberAccountIds.Num());
+
+	if (Batch->Result.bWasSuccessful)
+	{
+		if (!Batch->JoinedMemberAccountIds.IsEmpty())
+		{
+			LocalUserLobbyMembers.Emplace(Batch->LocalName, Batch->JoinedMemberAccountIds);
+		}
+	}
+
+	// Roll back so that either all local users are in the lobby or none of them
+
+	else
+	{
+		LeaveLobbyForLocalUsers(Batch->LobbyId, Batch->Context, Batch->JoinedMemberAccountIds);
+
+		// The primary user may not be the first local player, so leave with the account that joined
+
+		if (Batch->bPrimaryJoined && Batch->PrimaryAccountId.IsValid() && Batch->LobbyId.IsValid() && GetLobbiesInterface(Batch->Context))
+		{
+			ReleaseLobbyMapPreload(Batch->LocalName);
+
+			CleanUpLobbyInternal(Batch->LocalName, Batch->PrimaryAccountId, Batch->LobbyId, Batch->Context, FLobbyLeaveCompleteDelegate::CreateWeakLambda(this, [](FOnlineServiceResult) {}));
+		}
+	}
+
+	if (auto* CreateRequest{ Batch->CreateRequest.Get() })
+	{
+		if (!Batch->Result.bWasSuccessful)
+		{
+			CreateRequest->Result = nullptr;
+		}
+
+		Batch->CreateDelegate.ExecuteIfBound(CreateRequest, Batch->Result);
+		BroadcastLobbyCreateComplete(CreateRequest, Batch->Result);
+	}
+	else if (auto* JoinRequest{ Batch->JoinRequest.Get() })
+	{
+		Batch->JoinDelegate.ExecuteIfBound(JoinRequest, Batch->Result);
+		BroadcastLobbyJoinComplete(JoinRequest, Batch->Result);
+	}
+}
+
+void UOnlineLobbySubsystem::CancelLocalUsersLobbyBatch(FName LocalName)
+{
+	const auto* Found{ LocalUsersLobbyBatches.Find(LocalName) };
+	if (!Found)
+	{
+		return;
+	}
+
+	const auto Batch{ *Found };
+	LocalUsersLobbyBatches.Remove(LocalName);
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Cancel Lobby For Local Users"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumPending: %d"), Batch->NumPending);
+
+	// The caller leaves the lobby with the primary user, members who have already joined are left by the roll back
+
+	Batch->Result = FOnlineServiceResult(Errors::Cancelled());
+	Batch->bPrimaryJoined = false;
+	Batch->NumPending = 0;
+
+	TryCompleteLocalUsersBatch(Batch);
+}
+
+void UOnlineLobbySubsystem::LeaveLobbyForLocalUsers(const FLobbyId& LobbyId, EOnlineServiceContext Context, const TArray<FAccountId>& AccountIds)
+{
+	auto LobbiesInterface{ GetLobbiesInterface(Context) };
+	if (!LobbiesInterface || !LobbyId.IsValid())
+	{
+		return;
+	}
+
+	for (const auto& AccountId : AccountIds)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Leave Lobby For Local User"));
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(AccountId));
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+
+		FLeaveLobby::Params Params;
+		Params.LobbyId = LobbyId;
+		Params.LocalAccountId = AccountId;
+
+		LobbiesInterface->LeaveLobby(MoveTemp(Params));
+	}
+}
+
+
+// Lobby History
+
+void UOnlineLobbySubsystem::ReportLobbyJoinFailure(const FLobbyId& LobbyId, ELobbyJoinFailureReason Reason)
+{
+	if (!LobbyId.IsValid())
+	{
+		return;
+	}
+
+	auto& Entry{ FindOrAddLobbyHistory(LobbyId) };
+	Entry.NumJoinFailures++;
+	Entry.LastJoinFailureTime = Entry.LastUpdateTime;
+
+	BlacklistLobby(LobbyId, Reason);
+}
+
+void UOnlineLobbySubsystem::ReportLobbyLatency(const ULobbyResult* LobbyResult, float LatencyMs)
+{
+	if (!LobbyResult || !LobbyResult->GetLobbyId().IsValid() || (LatencyMs < 0.0f))
+	{
+		return;
+	}
+
+	auto& Entry{ FindOrAddLobbyHistory(LobbyResult->GetLobbyId()) };
+	Entry.LatencyMs = LatencyMs;
+}
+
+FLobbyHistoryEntry& UOnlineLobbySubsystem::FindOrAddLobbyHistory(const FLobbyId& LobbyId)
+{
+	TrimLobbyHistory();
+
+	auto& Entry{ LobbyHistory.FindOrAdd(LobbyId) };
+	Entry.LastUpdateTime = FPlatformTime::Seconds();
+
+	return Entry;
+}
+
+void UOnlineLobbySubsystem::TrimLobbyHistory()
+{
+	const auto Now{ FPlatformTime::Seconds() };
+	const auto RetentionTime{ GetDefault<UOnlineDeveloperSettings>()->GetLobbyHistoryRetentionTime() };
+
+	for (auto It{ LobbyHistory.CreateIterator() }; It; ++It)
+	{
+		if ((Now - It->Value.LastUpdateTime) > RetentionTime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+
+// Lobby Blacklist
+
+void UOnlineLobbySubsystem::BlacklistLobby(const FLobbyId& LobbyId, ELobbyJoinFailureReason Reason)
+{
+	const auto Duration{ GetDefault<UOnlineDeveloperSettings>()->GetLobbyBlacklistDuration(Reason) };
+
+	if (!LobbyId.IsValid() || (Reason == ELobbyJoinFailureReason::MAX) || (Duration <= 0.0))
+	{
+		return;
+	}
+
+	TrimLobbyBlacklist();
+
+	const auto Now{ FPlatformTime::Seconds() };
+	auto& Stats{ LobbyBlacklistStats[static_cast<uint8>(Reason)] };
+	auto& Entry{ LobbyBlacklist.FindOrAdd(LobbyId) };
+
+	// Failed again for the same reason soon after the previous entry expired
+
+	if ((Entry.Reason == Reason) && (Entry.ExpireTime > 0.0) && Entry.IsExpired(Now))
+	{
+		Stats.NumRepeatedAfterExpiry++;
+	}
+
+	Stats.NumAdded++;
+
+	Entry.Reason = Reason;
+	Entry.ExpireTime = Now + Duration;
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Blacklist Lobby"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Reason: %s"), *StaticEnum<ELobbyJoinFailureReason>()->GetNameStringByValue(static_cast<int64>(Reason)));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Duration: %.2fs"), Duration);
+}
+
+bool UOnlineLobbySubsystem::IsLobbyBlacklisted(const FLobbyId& LobbyId, bool bCountHit)
+{
+	const auto* Entry{ LobbyBlacklist.Find(LobbyId) };
+
+	if (!Entry || Entry->IsExpired(FPlatformTime::Seconds()))
+	{
+		return false;
+	}
+
+	if (bCountHit)
+	{
+		LobbyBlacklistStats[static_cast<uint8>(Entry->Reason)].NumHits++;
+	}
+
+	return true;
+}
+
+FLobbyBlacklistStats UOnlineLobbySubsystem::GetLobbyBlacklistStats(ELobbyJoinFailureReason Reason) const
+{
+	return (Reason < ELobbyJoinFailureReason::MAX) ? LobbyBlacklistStats[static_cast<uint8>(Reason)] : FLobbyBlacklistStats();
+}
+
+void UOnlineLobbySubsystem::ClearLobbyBlacklist()
+{
+	LobbyBlacklist.Reset();
+}
+
+ELobbyJoinFailureReason UOnlineLobbySubsystem::ClassifyLobbyJoinFailure(const FOnlineError& Error, const ULobbyResult* LobbyResult)
+{
+	if (Error == Errors::NotFound())
+	{
+		return ELobbyJoinFailureReason::NotFound;
+	}
+
+	if (Error == Errors::AccessDenied())
+	{
+		return ELobbyJoinFailureReason::JoinPolicy;
+	}
+
+	// Online services do not share an error for full lobbies, so rely on the last known state of the lobby
+	// Lobbies decoded from a handoff do not know their capacity, so they are never considered full
+
+	if (LobbyResult && LobbyResult->GetLobby() && (LobbyResult->GetLobby()->MaxMembers > 0) && (LobbyResult->GetNumOpenSlot() <= 0))
+	{
+		return ELobbyJoinFailureReason::Full;
+	}
+
+	return ELobbyJoinFailureReason::Unknown;
+}
+
+void UOnlineLobbySubsystem::TrimLobbyBlacklist()
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	const auto Now{ FPlatformTime::Seconds() };
+
+	for (auto It{ LobbyBlacklist.CreateIterator() }; It; ++It)
+	{
+		if ((Now - It->Value.ExpireTime) > DevSettings->GetLobbyBlacklistDuration(It->Value.Reason))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+
+// Clean Up Lobby
+
+bool UOnlineLobbySubsystem::CleanUpLobby(FName LocalName, const APlayerController* InPlayerController, FLobbyLeaveCompleteDelegate Delegate)
+{
+	if (!OnlineServiceSubsystem->IsOnlineServiceReady())
+	{
+		return false;
+	}
+
+	CancelLocalUsersLobbyBatch(LocalName);
+
+	CleanUpOngoingRequest(LocalName);
+
+	ReleaseLobbyMapPreload(LocalName);
+
+	auto* PlayerController{ InPlayerController ? InPlayerController : GetGameInstance()->GetFirstLocalPlayerController() };
+	auto* LocalPlayer{ PlayerController ? PlayerController->GetLocalPlayer() : nullptr };
+
+	const auto* LobbyResult{ GetJoinedLobby(LocalName) };
+	auto Lobby{ LobbyResult ? LobbyResult->GetLobby() : nullptr };
+	auto LobbyId{ Lobby ? Lobby->LobbyId : FLobbyId() };
+	const auto Context{ LobbyResult ? LobbyResult->GetServiceContext() : EOnlineServiceContext::Default };
+
+	auto LocalAccountId{ GetLocalAccountId(LocalPlayer, Context) };
+
+	// Other local users who joined with the primary user leave as well
+
+	TArray<FAccountId> MemberAccountIds;
+	if (LocalUserLobbyMembers.RemoveAndCopyValue(LocalName, MemberAccountIds) && LobbyId.IsValid())
+	{
+		LeaveLobbyForLocalUsers(LobbyId, Context, MemberAccountIds);
+	}
+
+	if (LocalAccountId.IsValid() && LobbyId.IsValid() && GetLobbiesInterface(Context))
+	{
+		CleanUpLobbyInternal(LocalName, LocalAccountId, LobbyId, Context, Delegate);
+		return true;
+	}
+	else
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("CleanUpLobby failed"));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("| LocalAccountId: %s"), *ToLogString(LocalAccountId));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("| Context: %s"), *StaticEnum<EOnlineServiceContext>()->GetNameStringByValue(static_cast<int64>(Context)));
+
+		return false;
+	}
+}
+
+void UOnlineLobbySubsystem::CleanUpLobbyInternal(FName LocalName, const FAccountId& LocalAccountId, const FLobbyId& LobbyId, EOnlineServiceContext Context, FLobbyLeaveCompleteDelegate Delegate)
+{
+	check(LocalName.IsValid());
+	check(LocalAccountId.IsValid());
+	check(LobbyId.IsValid());
+	ensure(Delegate.IsBound());
+
+	auto LobbiesInterface{ GetLobbiesInterface(Context) };
+	check(LobbiesInterface);
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("CleanUpLobby: Leave Lobby"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalAccountId: %s"), *ToLogString(LocalAccountId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+
+	// Leaves of lobbies that have no result object are tracked with the subsystem as the request
+
+	UObject* Request{ JoiningLobbies.FindRef(LocalName) };
+	const auto OperationKey{ BeginOperation(LocalName, ELobbyOperationType::Leave, Request ? Request : this) };
+
+	FLeaveLobby::Params Param;
+	Param.LobbyId = LobbyId;
+	Param.LocalAccountId = LocalAccountId;
+
+	auto Handle{ LobbiesInterface->LeaveLobby(MoveTemp(Param)) };
+	Handle.OnComplete(this, &ThisClass::HandleLeaveLobbyComplete, OperationKey, Delegate);
+
+	ArmOperation<FLeaveLobby>(OperationKey, Handle, [this, OperationKey, Delegate](const TOnlineResult<FLeaveLobby>& Result)
+	{
+		HandleLeaveLobbyComplete(Result, OperationKey, Delegate);
+	});
+}
+
+void UOnlineLobbySubsystem::HandleLeaveLobbyComplete(const TOnlineResult<FLeaveLobby>& LeaveResult, FLobbyOperationKey OperationKey, FLobbyLeaveCompleteDelegate Delegate)
+{
+	// The leave has already been aborted
+
+	if (!OngoingOperations.Contains(OperationKey))
+	{
+		return;
+	}
+
+	EndOperation(OperationKey);
+
+	const auto LocalName{ OperationKey.LocalName };
+	const auto bSuccess{ LeaveResult.IsOk() };
 
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Leave Lobby Completed"));
 	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *LeaveResult.GetErrorValue().GetLogString());
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *LeaveResult.GetErrorValue().GetLogString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *LocalName.ToString());
+
+	FOnlineServiceResult ServiceResult;
+
+	if (bSuccess)
+	{
+		RemoveJoiningLobby(LocalName);
+	}
+	else
+	{
+		ServiceResult = FOnlineServiceResult(LeaveResult.GetErrorValue());
+	}
+
+	ensure(Delegate.IsBound());
+	Delegate.ExecuteIfBound(ServiceResult);
+}
+
+void UOnlineLobbySubsystem::CleanUpOngoingRequest(FName LocalName)
+{
+	for (auto It{ OngoingOperations.CreateIterator() }; It; ++It)
+	{
+		const auto Type{ It->Value.Type };
+
+		if ((It->Key.LocalName != LocalName) || (Type == ELobbyOperationType::Modify) || (Type == ELobbyOperationType::Leave))
+		{
+			continue;
+		}
+
+		if (Type != ELobbyOperationType::Search)
+		{
+			AbortedOperations.Emplace(It->Key);
+		}
+
+		It.RemoveCurrent();
+	}
+}
+
+
+// Join Lobby Request
+
+void UOnlineLobbySubsystem::NotifyUserJoinLobbyRequest(const FPlatformUserId& LocalPlatformUserId, ULobbyResult* RequestedLobby, FOnlineServiceResult Result)
+{
+	OnUserJoinLobbyRequest.Broadcast(LocalPlatformUserId, RequestedLobby, Result);
+
+	if (K2_OnUserJoinLobbyRequest.IsBound())
+	{
+		K2_OnUserJoinLobbyRequest.Broadcast(LocalPlatformUserId, RequestedLobby, Result);
+	}
+}
+
+
+// Staged Lobby Invite
+
+bool UOnlineLobbySubsystem::HasStagedLobbyInvite() const
+{
+	return StagedInviteJoinRequest && !StagedInviteConfirmingPlayer.IsValid();
+}
+
+bool UOnlineLobbySubsystem::ConfirmStagedLobbyInvite(APlayerController* InPlayerController)
+{
+	if (!HasStagedLobbyInvite())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Confirm Staged Lobby Invite Failed: No staged invite"));
+		return false;
+	}
+
+	if (!InPlayerController)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Confirm Staged Lobby Invite Failed: Invalid Player Controller"));
+		return false;
+	}
+
+	GetGameInstance()->GetTimerManager().ClearTimer(StagedInviteTimeoutHandle);
+
+	// Travel as soon as the join completes
+
+	if (!bStagedInviteJoinCompleted)
+	{
+		StagedInviteConfirmingPlayer = InPlayerController;
+		return true;
+	}
+
+	auto* JoinRequest{ StagedInviteJoinRequest.Get() };
+	const auto Result{ StagedInviteResult };
+
+	ResetStagedInvite();
+
+	// The join is only reported once the invite has been accepted
+
+	BroadcastLobbyJoinComplete(JoinRequest, Result);
+
+	return Result.bWasSuccessful && TravelToLobby(InPlayerController, JoinRequest->LobbyToJoin);
+}
+
+void UOnlineLobbySubsystem::RejectStagedLobbyInvite()
+{
+	if (!StagedInviteJoinRequest)
+	{
+		return;
+	}
+
+	// Leave once the join completes, the staged invite is released so a new invite can be staged in the meantime
+
+	if (!bStagedInviteJoinCompleted)
+	{
+		RejectedInviteJoinRequests.Add(StagedInviteJoinRequest);
+
+		ResetStagedInvite();
+		return;
+	}
+
+	auto* JoinRequest{ StagedInviteJoinRequest.Get() };
+	const auto InvitedAccountId{ StagedInviteAccountId };
+	const auto bJoined{ StagedInviteResult.bWasSuccessful };
+
+	ResetStagedInvite();
+
+	if (bJoined)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Reject Staged Lobby Invite: Leave Lobby (LocalName: %s)"), *JoinRequest->LocalName.ToString());
+
+		LeaveRejectedInviteLobby(JoinRequest, InvitedAccountId);
+	}
+}
+
+bool UOnlineLobbySubsystem::StartSpeculativeInviteJoin(const FPlatformUserId& LocalPlatformUserId, ULobbyResult* RequestedLobby)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	if (!DevSettings->ShouldSpeculativeInviteJoin() || !RequestedLobby)
+	{
+		return false;
+	}
+
+	// A new invite replaces the one waiting to be accepted
+
+	RejectStagedLobbyInvite();
+
+	auto* LocalPlayer{ GetGameInstance()->FindLocalPlayerFromPlatformUserId(LocalPlatformUserId) };
+	if (!LocalPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Speculative Invite Join skipped: No local player for platform user (%d)"), LocalPlatformUserId.GetInternalId());
+		return false;
+	}
+
+	auto* JoinRequest{ CreateOnlineLobbyJoinRequest(RequestedLobby) };
+	const auto LocalName{ JoinRequest->LocalName };
+
+	if (JoiningLobbies.Contains(LocalName) || HasOngoingOperation(LocalName, ELobbyOperationType::Create) || HasOngoingOperation(LocalName, ELobbyOperationType::Join))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Speculative Invite Join skipped: Lobby already joined or in progress (LocalName: %s)"), *LocalName.ToString());
+		return false;
+	}
+
+	FString OutError;
+	if (!ValidateLobbyContext(LocalPlayer, RequestedLobby->GetServiceContext(), OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Speculative Invite Join skipped: %s"), *OutError);
+		return false;
+	}
+
+	const auto LocalAccountId{ GetLocalAccountId(LocalPlayer, RequestedLobby->GetServiceContext()) };
+
+	ResetStagedInvite();
+
+	StagedInviteJoinRequest = JoinRequest;
+	StagedInviteAccountId = LocalAccountId;
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Speculative Invite Join"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(RequestedLobby->GetLobbyId()));
+
+	// Load the map in parallel with the join, the connect string is resolved as soon as the join completes
+
+	FString MapName;
+	if (RequestedLobby->GetLobbyAttributeAsString(SETTING_MAPNAME, MapName))
+	{
+		StartLobbyMapPreload(LocalName, MapName, true);
+	}
+
+	// The join completion is broadcast once the invite is accepted, not when the speculative join completes
+
+	JoinOnlineLobbyInternal(LocalPlayer, JoinRequest, FLobbyJoinCompleteDelegate::CreateUObject(this, &ThisClass::HandleSpeculativeInviteJoinComplete, LocalAccountId), false);
+
+	const auto Timeout{ DevSettings->GetStagedInviteTimeout() };
+	if (Timeout > 0.0f)
+	{
+		GetGameInstance()->GetTimerManager().SetTimer(StagedInviteTimeoutHandle, FTimerDelegate::CreateUObject(this, &ThisClass::HandleStagedInviteTimeout), Timeout, false);
+	}
+
+	return true;
+}
+
+void UOnlineLobbySubsystem::HandleSpeculativeInviteJoinComplete(ULobbyJoinRequest* JoinRequest, FOnlineServiceResult Result, FAccountId InvitedAccountId)
+{
+	if (!JoinRequest)
+	{
+		return;
+	}
+
+	// Rejected while joining
+
+	if (RejectedInviteJoinRequests.Remove(JoinRequest) > 0)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Speculative Invite Join Completed after rejection"));
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *JoinRequest->LocalName.ToString());
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), Result.bWasSuccessful ? TEXT("Success") : TEXT("Failed"));
+
+		if (Result.bWasSuccessful)
+		{
+			LeaveRejectedInviteLobby(JoinRequest, InvitedAccountId);
+		}
+
+		return;
+	}
+
+	if (JoinRequest != StagedInviteJoinRequest)
+	{
+		return;
+	}
+
+	bStagedInviteJoinCompleted = true;
+	StagedInviteResult = Result;
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Speculative Invite Join Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), Result.bWasSuccessful ? TEXT("Success") : TEXT("Failed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| State: %s"), StagedInviteConfirmingPlayer.IsValid() ? TEXT("Confirmed") : TEXT("Staged"));
+
+	// Accepted while joining
+
+	if (auto* ConfirmingPlayer{ StagedInviteConfirmingPlayer.Get() })
+	{
+		ResetStagedInvite();
+
+		BroadcastLobbyJoinComplete(JoinRequest, Result);
+
+		if (Result.bWasSuccessful)
+		{
+			TravelToLobby(ConfirmingPlayer, JoinRequest->LobbyToJoin);
+		}
+
+		return;
+	}
+
+	// Nothing to stage, the game can still join the lobby normally
+
+	if (!Result.bWasSuccessful)
+	{
+		ResetStagedInvite();
+	}
+}
+
+void UOnlineLobbySubsystem::LeaveRejectedInviteLobby(ULobbyJoinRequest* JoinRequest, const FAccountId& InvitedAccountId)
+{
+	const auto LocalName{ JoinRequest->LocalName };
+
+	ReleaseLobbyMapPreload(LocalName);
+
+	const auto* LobbyResult{ JoinRequest->LobbyToJoin.Get() };
+	const auto LobbyId{ LobbyResult ? LobbyResult->GetLobbyId() : FLobbyId() };
+	const auto Context{ LobbyResult ? LobbyResult->GetServiceContext() : EOnlineServiceContext::Default };
+
+	if (!InvitedAccountId.IsValid() || !LobbyId.IsValid() || !GetLobbiesInterface(Context))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Leave Rejected Invite Lobby failed"));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("| LocalName: %s"), *LocalName.ToString());
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("| InvitedAccountId: %s"), *ToLogString(InvitedAccountId));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+		return;
+	}
+
+	CleanUpLobbyInternal(LocalName, InvitedAccountId, LobbyId, Context, FLobbyLeaveCompleteDelegate::CreateWeakLambda(this, [](FOnlineServiceResult) {}));
+}
+
+void UOnlineLobbySubsystem::HandleStagedInviteTimeout()
+{
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Staged Lobby Invite timed out"));
+
+	RejectStagedLobbyInvite();
+}
+
+void UOnlineLobbySubsystem::ResetStagedInvite()
+{
+	if (auto* GameInstance{ GetGameInstance() })
+	{
+		GameInstance->GetTimerManager().ClearTimer(StagedInviteTimeoutHandle);
+	}
+
+	StagedInviteJoinRequest = nullptr;
+	StagedInviteResult = FOnlineServiceResult();
+	bStagedInviteJoinCompleted = false;
+	StagedInviteAccountId = FAccountId();
+	StagedInviteConfirmingPlayer.Reset();
+}
+
+
+// Lobby Handoff
+
+bool UOnlineLobbySubsystem::HandoffLobby(APlayerController* InPlayerController, const ULobbyResult* PartyLobby, const ULobbyResult* GameLobby, FLobbyModifyCompleteDelegate Delegate)
+{
+	if (!InPlayerController)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Handoff Lobby Failed: Invalid Player Controller"));
+		return false;
+	}
+
+	auto* LocalPlayer{ InPlayerController->GetLocalPlayer() };
+	if (!LocalPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Handoff Lobby Failed: Can't get LocalPlayer from PlayerController(%s)"), *GetNameSafe(InPlayerController));
+		return false;
+	}
+
+	if (!PartyLobby || !PartyLobby->GetLobby())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Handoff Lobby Failed: Invalid Party Lobby"));
+		return false;
+	}
+
+	if (!GameLobby || !GameLobby->GetLobby())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Handoff Lobby Failed: Invalid Game Lobby"));
+		return false;
+	}
+
+	if (PartyLobby->GetServiceContext() != GameLobby->GetServiceContext())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Handoff Lobby Failed: The party lobby and the game lobby are in different service contexts"));
+		return false;
+	}
+
+	FString OutError;
+	if (!ValidateLobbyContext(LocalPlayer, PartyLobby->GetServiceContext(), OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Handoff Lobby Failed: %s"), *OutError);
+		return false;
+	}
+
+	const auto AccountId{ GetLocalAccountId(LocalPlayer, PartyLobby->GetServiceContext()) };
+	if (PartyLobby->GetOwnerAccountId() != AccountId)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Handoff Lobby Failed: LocalPlayer(%s) is not the leader of the party lobby"), *GetNameSafe(LocalPlayer));
+		return false;
+	}
+
+	const auto Value{ EncodeLobbyHandoff(GameLobby) };
+	if (Value.IsEmpty())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Handoff Lobby Failed: Can't encode Game Lobby(%s)"), *GetNameSafe(GameLobby));
+		return false;
+	}
+
+	if (!Delegate.IsBound())
+	{
+		Delegate = FLobbyModifyCompleteDelegate::CreateWeakLambda(this, [](const ULobbyResult*, FOnlineServiceResult) {});
+	}
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Handoff Lobby"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| PartyLobbyId: %s"), *ToLogString(PartyLobby->GetLobbyId()));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| GameLobbyId: %s"), *ToLogString(GameLobby->GetLobbyId()));
+
+	// Bypass the debounce window, party members are waiting for this write
+
+	const FLobbyAttribute HandoffAttribute{ GetDefault<UOnlineDeveloperSettings>()->GetLobbyHandoffAttributeName(), Value };
+
+	ModifyLobbyAttributeInternal(LocalPlayer, PartyLobby, { HandoffAttribute }, {}, Delegate);
+	return true;
+}
+
+FString UOnlineLobbySubsystem::EncodeLobbyHandoff(const ULobbyResult* GameLobby) const
+{
+	check(GameLobby);
+
+	const auto LobbyId{ GameLobby->GetLobbyId() };
+	if (!LobbyId.IsValid())
+	{
+		return FString();
+	}
+
+	const auto LobbyIdData{ FOnlineIdRegistryRegistry::Get().ToReplicationData(LobbyId) };
+	if (LobbyIdData.IsEmpty())
+	{
+		return FString();
+	}
+
+	FString MapName;
+	GameLobby->GetLobbyAttributeAsString(SETTING_MAPNAME, MapName);
+
+	// LocalName|MapName|LobbyId, the map is sent along so that it can be loaded while joining
+
+	return FString::Printf(TEXT("%s|%s|%s"), *GameLobby->GetLocalName().ToString(), *MapName, *FBase64::Encode(LobbyIdData));
+}
+
+ULobbyResult* UOnlineLobbySubsystem::DecodeLobbyHandoff(const FString& Value, EOnlineServiceContext Context)
+{
+	TArray<FString> Parts;
+	if (Value.ParseIntoArray(Parts, TEXT("|"), false) != 3 || Parts[0].IsEmpty())
+	{
+		return nullptr;
+	}
+
+	auto OnlineServices{ OnlineServiceSubsystem ? OnlineServiceSubsystem->GetContextCache(Context) : nullptr };
+	if (!OnlineServices)
+	{
+		return nullptr;
+	}
+
+	TArray<uint8> LobbyIdData;
+	if (!FBase64::Decode(Parts[2], LobbyIdData))
+	{
+		return nullptr;
+	}
+
+	const auto LobbyId{ FOnlineIdRegistryRegistry::Get().ToLobbyId(OnlineServices->GetServicesProvider(), LobbyIdData) };
+	if (!LobbyId.IsValid())
+	{
+		return nullptr;
+	}
+
+	// Only what is needed to join, the result is overwritten with the joined lobby once the join completes
+
+	auto Lobby{ MakeShared<FLobby>() };
+	Lobby->LobbyId = LobbyId;
+	Lobby->LocalName = FName(*Parts[0]);
+
+	if (!Parts[1].IsEmpty())
+	{
+		Lobby->Attributes.Emplace(GetDefault<UOnlineDeveloperSettings>()->RedirectLobbyAttribute_ToOnlineService(SETTING_MAPNAME), Parts[1]);
+	}
+
+	auto* NewResult{ NewObject<ULobbyResult>(this) };
+	NewResult->InitializeResult(Lobby);
+	NewResult->SetServiceContext(Context);
+
+	return NewResult;
+}
+
+void UOnlineLobbySubsystem::HandleLobbyHandoff(const FLobby& PartyLobby)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	check(DevSettings);
+
+	const auto* Value{ PartyLobby.Attributes.Find(DevSettings->RedirectLobbyAttribute_ToOnlineService(DevSettings->GetLobbyHandoffAttributeName())) };
+	if (!Value)
+	{
+		return;
+	}
+
+	const auto* PartyLobbyResult{ GetJoinedLobby(PartyLobby.LocalName) };
+	const auto Context{ PartyLobbyResult ? PartyLobbyResult->GetServiceContext() : EOnlineServiceContext::Default };
+
+	// Every local user in the party follows, the one who joined it directly leads the join and the others join alongside
+
+	const auto MemberAccountIds{ LocalUserLobbyMembers.FindRef(PartyLobby.LocalName) };
+
+	ULocalPlayer* LocalPlayer{ nullptr };
+
+	for (auto* Player : GetGameInstance()->GetLocalPlayers())
+	{
+		const auto PlayerAccountId{ GetLocalAccountId(Player, Context) };
+
+		if (PlayerAccountId.IsValid() && PartyLobby.Members.Contains(PlayerAccountId) && !MemberAccountIds.Contains(PlayerAccountId))
+		{
+			LocalPlayer = Player;
+			break;
+		}
+	}
+
+	const auto AccountId{ GetLocalAccountId(LocalPlayer, Context) };
+
+	// The leader has already joined the game lobby it handed off, together with the local users of its device
+
+	if (!AccountId.IsValid() || (PartyLobby.OwnerAccountId == AccountId) || MemberAccountIds.Contains(PartyLobby.OwnerAccountId))
+	{
+		return;
+	}
+
+	auto* GameLobby{ DecodeLobbyHandoff(Value->GetString(), Context) };
+	if (!GameLobby)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Handle Lobby Handoff Failed: Invalid value of handoff attribute in Party Lobby(%s)"), *PartyLobby.LocalName.ToString());
+		return;
+	}
+
+	const auto GameLocalName{ GameLobby->GetLocalName() };
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("On Lobby Handoff"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| PartyLocalName: %s"), *PartyLobby.LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| GameLocalName: %s"), *GameLocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| GameLobbyId: %s"), *ToLogString(GameLobby->GetLobbyId()));
+
+	if (const auto* JoinedLobby{ GetJoinedLobby(GameLocalName) })
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Skipped: %s"), JoinedLobby->GetLobbyId() == GameLobby->GetLobbyId() ? TEXT("Already Joined") : TEXT("Another lobby joined with the same LocalName"));
+		return;
+	}
+
+	if (HasOngoingOperation(GameLocalName, ELobbyOperationType::Create) || HasOngoingOperation(GameLocalName, ELobbyOperationType::Join))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Skipped: A request already in progress exists"));
+		return;
+	}
+
+	auto* JoinRequest{ CreateOnlineLobbyJoinRequest(GameLobby) };
+	JoinRequest->LocalName = GameLocalName;
+
+	// Join right away, the map is preloaded while joining
+
+	if (DevSettings->ShouldAutoJoinLobbyHandoff() && GetLobbiesInterface(Context))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| NumLocalUsers: %d"), MemberAccountIds.Num() + 1);
+
+		auto CompleteDelegate
+		{
+			FLobbyJoinCompleteDelegate::CreateWeakLambda(this, [](ULobbyJoinRequest* InJoinRequest, FOnlineServiceResult Result)
+			{
+				if (!Result.bWasSuccessful)
+				{
+					UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Follow Lobby Handoff Failed"));
+					UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("| GameLocalName: %s"), InJoinRequest ? *InJoinRequest->LocalName.ToString() : TEXT("None"));
+					UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("| Error: %s"), *Result.ErrorId);
+				}
+			})
+		};
+
+		if (MemberAccountIds.IsEmpty())
+		{
+			JoinOnlineLobbyInternal(LocalPlayer, JoinRequest, CompleteDelegate);
+		}
+		else if (!JoinLobbyForLocalUsersInternal(LocalPlayer, MemberAccountIds, JoinRequest, CompleteDelegate))
+		{
+			UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Follow Lobby Handoff Failed: Could not start the join for local users (GameLocalName: %s)"), *GameLocalName.ToString());
+		}
+	}
+
+	NotifyLobbyHandoffReceived(PartyLobby.LocalName, JoinRequest);
+}
+
+void UOnlineLobbySubsystem::NotifyLobbyHandoffReceived(FName PartyLocalName, ULobbyJoinRequest* JoinRequest)
+{
+	OnLobbyHandoffReceived.Broadcast(PartyLocalName, JoinRequest);
+
+	if (K2_OnLobbyHandoffReceived.IsBound())
+	{
+		K2_OnLobbyHandoffReceived.Broadcast(PartyLocalName, JoinRequest);
+	}
+}
+
+
+// Lobby Event Dispatch
+
+bool UOnlineLobbySubsystem::ShouldQueueLobbyEvents() const
+{
+	return GetDefault<UOnlineDeveloperSettings>()->ShouldCoalesceLobbyEvents();
+}
+
+void UOnlineLobbySubsystem::ScheduleLobbyEventFlush()
+{
+	auto& TimerManager{ GetGameInstance()->GetTimerManager() };
+
+	if (!TimerManager.TimerExists(LobbyEventFlushTimerHandle))
+	{
+		LobbyEventFlushTimerHandle = TimerManager.SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::FlushLobbyEvents));
+	}
+}
+
+void UOnlineLobbySubsystem::FlushLobbyEvents()
+{
+	LobbyEventFlushTimerHandle.Invalidate();
+
+	auto Events{ MoveTemp(PendingLobbyEvents) };
+	PendingLobbyEvents = FPendingLobbyEvents();
+
+	for (const auto& KVP : Events.MemberChanged)
+	{
+		BroadcastLobbyMemberChanged(KVP.Key, KVP.Value.Key, KVP.Value.Value);
+	}
+
+	for (const auto& LocalName : Events.LeaderChanged)
+	{
+		BroadcastLobbyLeaderChanged(LocalName);
+	}
+
+	for (const auto& LocalName : Events.BecomeLeader)
+	{
+		BroadcastLobbyBecomeLeader(LocalName);
+	}
+
+	for (const auto& KVP : Events.AttributesChanged)
+	{
+		if (!KVP.Value.IsEmpty())
+		{
+			BroadcastLobbyAttributesChanged(KVP.Value);
+		}
+	}
+
+	for (const auto& KVP : Events.MemberAttributesChanged)
+	{
+		if (!KVP.Value.IsEmpty())
+		{
+			BroadcastLobbyMemberAttributesChanged(KVP.Value);
+		}
+	}
+
+	NotifyLobbyRosterChanged();
+}
+
+
+// Lobby Member Change
+
+void UOnlineLobbySubsystem::NotifyLobbyMemberChanged(FName LocalName, int32 CurrentMembers, int32 MaxMembers)
+{
+	if (ShouldQueueLobbyEvents())
+	{
+		PendingLobbyEvents.MemberChanged.Emplace(LocalName, TPair<int32, int32>(CurrentMembers, MaxMembers));
+		ScheduleLobbyEventFlush();
+		return;
+	}
+
+	BroadcastLobbyMemberChanged(LocalName, CurrentMembers, MaxMembers);
+}
+
+void UOnlineLobbySubsystem::BroadcastLobbyMemberChanged(FName LocalName, int32 CurrentMembers, int32 MaxMembers)
+{
+	OnLobbyMemberChanged.Broadcast(LocalName, CurrentMembers, MaxMembers);
+
+	if (K2_OnLobbyMemberChanged.IsBound())
+	{
+		K2_OnLobbyMemberChanged.Broadcast(LocalName, CurrentMembers, MaxMembers);
+	}
+}
+
+
+// Lobby Roster
+
+FLobbyRoster& UOnlineLobbySubsystem::FindOrAddLobbyRoster(const FLobby& InLobby)
+{
+	if (auto* Found{ LobbyRosters.Find(InLobby.LocalName) })
+	{
+		return *Found;
+	}
+
+	auto& NewRoster{ LobbyRosters.Add(InLobby.LocalName) };
+	NewRoster.Reset(InLobby);
+
+	auto& Delta{ GetPendingRosterDelta(InLobby.LocalName) };
+
+	for (const auto& KVP : InLobby.Members)
+	{
+		Delta.MarkAdded(KVP.Key);
+	}
+
+	return NewRoster;
+}
+
+FLobbyRosterDelta& UOnlineLobbySubsystem::GetPendingRosterDelta(FName LocalName)
+{
+	// Notify all changes of this frame together at the next frame
+
+	ScheduleLobbyEventFlush();
+
+	if (auto* Found{ PendingRosterDeltas.Find(LocalName) })
+	{
+		return *Found;
+	}
+
+	return PendingRosterDeltas.Emplace(LocalName, FLobbyRosterDelta(LocalName));
+}
+
+void UOnlineLobbySubsystem::NotifyLobbyRosterChanged()
+{
+	auto Deltas{ MoveTemp(PendingRosterDeltas) };
+	PendingRosterDeltas.Reset();
+
+	for (const auto& KVP : Deltas)
+	{
+		if (KVP.Value.IsEmpty())
+		{
+			continue;
+		}
+
+		OnLobbyRosterChanged.Broadcast(KVP.Value);
+
+		if (K2_OnLobbyRosterChanged.IsBound())
+		{
+			K2_OnLobbyRosterChanged.Broadcast(KVP.Value);
+		}
+	}
+}
+
+
+// Lobby Attribute Change
+
+void UOnlineLobbySubsystem::NotifyLobbyAttributesChanged(const FLobbyAttributeChanges& Changes)
+{
+	if (ShouldQueueLobbyEvents())
+	{
+		if (auto* Found{ PendingLobbyEvents.AttributesChanged.Find(Changes.LocalName) })
+		{
+			Found->Append(Changes);
+		}
+		else
+		{
+			PendingLobbyEvents.AttributesChanged.Emplace(Changes.LocalName, Changes);
+		}
+
+		ScheduleLobbyEventFlush();
+		return;
+	}
+
+	BroadcastLobbyAttributesChanged(Changes);
+}
+
+void UOnlineLobbySubsystem::NotifyLobbyMemberAttributesChanged(const FLobbyAttributeChanges& Changes)
+{
+	if (ShouldQueueLobbyEvents())
+	{
+		const TPair<FName, FAccountId> Key{ Changes.LocalName, Changes.MemberId.GetV2() };
+
+		if (auto* Found{ PendingLobbyEvents.MemberAttributesChanged.Find(Key) })
+		{
+			Found->Append(Changes);
+		}
+		else
+		{
+			PendingLobbyEvents.MemberAttributesChanged.Emplace(Key, Changes);
+		}
+
+		ScheduleLobbyEventFlush();
+		return;
+	}
+
+	BroadcastLobbyMemberAttributesChanged(Changes);
+}
+
+void UOnlineLobbySubsystem::BroadcastLobbyAttributesChanged(const FLobbyAttributeChanges& Changes)
+{
+	OnLobbyAttributesChanged.Broadcast(Changes);
+
+	if (K2_OnLobbyAttributesChanged.IsBound())
+	{
+		K2_OnLobbyAttributesChanged.Broadcast(Changes);
+	}
+}
+
+void UOnlineLobbySubsystem::BroadcastLobbyMemberAttributesChanged(const FLobbyAttributeChanges& Changes)
+{
+	OnLobbyMemberAttributesChanged.Broadcast(Changes);
+
+	if (K2_OnLobbyMemberAttributesChanged.IsBound())
+	{
+		K2_OnLobbyMemberAttributesChanged.Broadcast(Changes);
+	}
+}
+
+
+// Lobby Leader Change
+
+void UOnlineLobbySubsystem::NotifyLobbyLeaderChanged(FName LocalName)
+{
+	if (ShouldQueueLobbyEvents())
+	{
+		PendingLobbyEvents.LeaderChanged.AddUnique(LocalName);
+		ScheduleLobbyEventFlush();
+		return;
+	}
+
+	BroadcastLobbyLeaderChanged(LocalName);
+}
+
+void UOnlineLobbySubsystem::NotifyLobbyBecomeLeader(FName LocalName)
+{
+	if (ShouldQueueLobbyEvents())
+	{
+		PendingLobbyEvents.BecomeLeader.AddUnique(LocalName);
+		ScheduleLobbyEventFlush();
+		return;
+	}
+
+	BroadcastLobbyBecomeLeader(LocalName);
+}
+
+void UOnlineLobbySubsystem::BroadcastLobbyLeaderChanged(FName LocalName)
+{
+	OnLobbyLeaderChanged.Broadcast(LocalName);
+
+	if (K2_OnLobbyLeaderChanged.IsBound())
+	{
+		K2_OnLobbyLeaderChanged.Broadcast(LocalName);
+	}
+}
+
+void UOnlineLobbySubsystem::BroadcastLobbyBecomeLeader(FName LocalName)
+{
+	OnLobbyBecomeLeader.Broadcast(LocalName);
+
+	if (K2_OnLobbyBecomeLeader.IsBound())
+	{
+		K2_OnLobbyBecomeLeader.Broadcast(LocalName);
+	}
+}
+
+
+// Travel Lobby
+
+bool UOnlineLobbySubsystem::TravelToLobby(APlayerController* InPlayerController, const ULobbyResult* LobbyResult)
+{
+	if (!InPlayerController)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid Player Controller"));
+		return false;
+	}
+
+	auto* LocalPlayer{ InPlayerController->GetLocalPlayer() };
+	if (!LocalPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Can't get LocalPlayer from PlayerController(%s)"), *GetNameSafe(InPlayerController));
+		return false;
+	}
+
+	const auto AccountId{ LocalPlayer->GetPreferredUniqueNetId().GetV2() };
+	if (!AccountId.IsValid())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid AccountId from LocalPlayer(%s)"), *GetNameSafe(LocalPlayer));
+		return false;
+	}
+
+	if (!LobbyResult)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid LobbyResult"));
+		return false;
+	}
+
+	const auto URL{ LobbyResult->GetLobbyTravelURL() };
+	if (URL.IsEmpty())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: No URL in LobbyResult(%s)"), *GetNameSafe(LobbyResult));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("If you have not joined the lobby, the URL does not exist."));
+		return false;
+	}
+
+	auto Lobby{ LobbyResult->GetLobby() };
+	if (!Lobby)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid Lobby in LobbyResult(%s)"), *GetNameSafe(LobbyResult));
+		return false;
+	}
+
+	auto* World{ GetWorld() };
+	if (!World)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid World"));
+		return false;
+	}
+
+	// Keep the preloaded map until the travel has loaded it
+
+	FLobbyMapPreload Preload;
+	if (LobbyMapPreloads.RemoveAndCopyValue(LobbyResult->GetLocalName(), Preload))
+	{
+		if (TravelMapPreloadHandle.IsValid())
+		{
+			TravelMapPreloadHandle->CancelHandle();
+		}
+
+		TravelMapPreloadHandle = MoveTemp(Preload.Handle);
+	}
+
+	// Start Travel
+
+	const auto bIsHost{ Lobby->OwnerAccountId == GetLocalAccountId(LocalPlayer, LobbyResult->GetServiceContext()) };
+
+	if (bIsHost)
+	{
+		return World->ServerTravel(URL);
+	}
+	else
+	{
+		InPlayerController->ClientTravel(URL, TRAVEL_Absolute);
+		return true;
+	}
+}
+
+
+// Lobby Map Preload
+
+bool UOnlineLobbySubsystem::IsLobbyMapPreloaded(FName LocalName) const
+{
+	const auto* Preload{ LobbyMapPreloads.Find(LocalName) };
+	return Preload && Preload->Handle.IsValid() && Preload->Handle->HasLoadCompleted();
+}
+
+void UOnlineLobbySubsystem::StartLobbyMapPreload(FName LocalName, const FString& MapName, bool bForce)
+{
+	if ((!bForce && !GetDefault<UOnlineDeveloperSettings>()->ShouldPreloadLobbyMap()) || MapName.IsEmpty() || !UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	if (const auto* Existing{ LobbyMapPreloads.Find(LocalName) })
+	{
+		if (Existing->MapName == MapName)
+		{
+			return;
+		}
+
+		ReleaseLobbyMapPreload(LocalName);
+	}
+
+	if (!FPackageName::IsValidLongPackageName(MapName))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Warning, TEXT("Preload Lobby Map skipped: Invalid map name (%s)"), *MapName);
+		return;
+	}
+
+	const FSoftObjectPath MapPath{ FTopLevelAssetPath(FName(*MapName), FName(*FPackageName::GetShortName(MapName))) };
+
+	auto Handle{ UAssetManager::GetStreamableManager().RequestAsyncLoad(MapPath, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority) };
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Start Preload Lobby Map"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LocalName: %s"), *LocalName.ToString());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Map: %s"), *MapName);
+
+	auto& NewPreload{ LobbyMapPreloads.Emplace(LocalName) };
+	NewPreload.MapName = MapName;
+	NewPreload.Handle = MoveTemp(Handle);
+}
+
+void UOnlineLobbySubsystem::ReleaseLobbyMapPreload(FName LocalName)
+{
+	FLobbyMapPreload Preload;
+	if (LobbyMapPreloads.RemoveAndCopyValue(LocalName, Preload) && Preload.Handle.IsValid())
+	{
+		// Cancels the load if still in progress, otherwise releases the loaded map
+
+		Preload.Handle->CancelHandle();
+	}
+}
+
+void UOnlineLobbySubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if (TravelMapPreloadHandle.IsValid())
+	{
+		TravelMapPreloadHandle->CancelHandle();
+		TravelMapPreloadHandle.Reset();
+	}
+}
+
+
+// Modify Lobby
+
+bool UOnlineLobbySubsystem::ModifyLobbyJoinPolicy(APlayerController* InPlayerController, const ULobbyResult* LobbyResult, ELobbyJoinablePolicy NewPolicy, FLobbyModifyCompleteDelegate Delegate)
+{
+	if (!InPlayerController)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Invalid Player Controller"));
+		return false;
+	}
+
+	auto* LocalPlayer{ InPlayerController->GetLocalPlayer() };
+	if (!LocalPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Can't get LocalPlayer from PlayerController(%s)"), *GetNameSafe(InPlayerController));
+		return false;
+	}
+
+	if (!LobbyResult)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Invalid LobbyResult"));
+		return false;
+	}
+
+	auto Lobby{ LobbyResult->GetLobby() };
+	if (!Lobby)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Invalid Lobby in LobbyResult(%s)"), *GetNameSafe(LobbyResult));
+		return false;
+	}
+
+	FString OutError;
+	if (!ValidateLobbyContext(LocalPlayer, LobbyResult->GetServiceContext(), OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: %s"), *OutError);
+		return false;
+	}
+
+	ModifyLobbyJoinPolicyInternal(LocalPlayer, LobbyResult, NewPolicy, Delegate);
+	return true;
+}
+
+void UOnlineLobbySubsystem::ModifyLobbyJoinPolicyInternal(ULocalPlayer* LocalPlayer, const ULobbyResult* LobbyResult, ELobbyJoinablePolicy NewPolicy, FLobbyModifyCompleteDelegate Delegate)
+{
+	check(LobbyResult);
+	auto LobbiesInterface{ GetLobbiesInterface(LobbyResult->GetServiceContext()) };
+	check(LobbiesInterface);
+
+	check(LocalPlayer);
+	const auto AccountId{ GetLocalAccountId(LocalPlayer, LobbyResult->GetServiceContext()) };
+	check(AccountId.IsValid());
+
+	const auto LobbyId{ LobbyResult->GetLobby()->LobbyId };
+	check(LobbyId.IsValid());
+
+	ensure(Delegate.IsBound());
+	
+	// Modify Join Policy
+
+	FModifyLobbyJoinPolicy::Params Params;
+	Params.JoinPolicy = static_cast<ELobbyJoinPolicy>(NewPolicy);
+	Params.LocalAccountId = AccountId;
+	Params.LobbyId = LobbyId;
+	
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Modify Lobby Join Plocy"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(Params.LocalAccountId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(Params.LobbyId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Policy: %s"), *StaticEnum<ELobbyJoinablePolicy>()->GetValueAsString(NewPolicy));
+
+	const auto OperationKey{ BeginOperation(LobbyResult->GetLocalName(), ELobbyOperationType::Modify, const_cast<ULobbyResult*>(LobbyResult)) };
+
+	auto Handle{ LobbiesInterface->ModifyLobbyJoinPolicy(MoveTemp(Params)) };
+	Handle.OnComplete(this, &ThisClass::HandleModifyLobbyJoinPolicyComplete, OperationKey, LobbyResult, Delegate);
+
+	ArmOperation<FModifyLobbyJoinPolicy>(OperationKey, Handle, [this, OperationKey, LobbyResult, Delegate](const TOnlineResult<FModifyLobbyJoinPolicy>& Result)
+	{
+		HandleModifyLobbyJoinPolicyComplete(Result, OperationKey, LobbyResult, Delegate);
+	});
+}
+
+void UOnlineLobbySubsystem::HandleModifyLobbyJoinPolicyComplete(const TOnlineResult<FModifyLobbyJoinPolicy>& ModifyResult, FLobbyOperationKey OperationKey, const ULobbyResult* LobbyResult, FLobbyModifyCompleteDelegate Delegate)
+{
+	// The modification has already been aborted
+
+	if (!OngoingOperations.Contains(OperationKey))
+	{
+		return;
+	}
+
+	EndOperation(OperationKey);
+
+	const auto bSuccess{ ModifyResult.IsOk() };
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Modify Lobby Join Plocy Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *ModifyResult.GetErrorValue().GetLogString());
+
+	FOnlineServiceResult ServiceResult;
+
+	if (!bSuccess)
+	{
+		ServiceResult = FOnlineServiceResult(ModifyResult.GetErrorValue());
+	}
+
+	ensure(Delegate.IsBound());
+	Delegate.ExecuteIfBound(LobbyResult, ServiceResult);
+}
+
+
+bool UOnlineLobbySubsystem::ModifyLobbyAttribute(APlayerController* InPlayerController, const ULobbyResult* LobbyResult, TSet<FLobbyAttribute> AttrToChange, TSet<FLobbyAttribute> AttrToRemove, FLobbyModifyCompleteDelegate Delegate)
+{
+	if (!InPlayerController)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Invalid Player Controller"));
+		return false;
+	}
+
+	auto* LocalPlayer{ InPlayerController->GetLocalPlayer() };
+	if (!LocalPlayer)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Can't get LocalPlayer from PlayerController(%s)"), *GetNameSafe(InPlayerController));
+		return false;
+	}
+
+	if (!LobbyResult)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Invalid LobbyResult"));
+		return false;
+	}
+
+	auto Lobby{ LobbyResult->GetLobby() };
+	if (!Lobby)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Invalid Lobby in LobbyResult(%s)"), *GetNameSafe(LobbyResult));
+		return false;
+	}
+
+	FString OutError;
+	if (!ValidateLobbyContext(LocalPlayer, LobbyResult->GetServiceContext(), OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: %s"), *OutError);
+		return false;
+	}
+
+	if (AttrToChange.IsEmpty() && AttrToRemove.IsEmpty())
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: No Attributes should be modified"));
+		return false;
+	}
+
+	// Merge with other modifications if the debounce window is enabled
+
+	if (GetDefault<UOnlineDeveloperSettings>()->IsLobbyAttributeModifyDebounceEnabled())
+	{
+		QueueLobbyAttributeModification(LocalPlayer, LobbyResult, AttrToChange, AttrToRemove, Delegate);
+		return true;
+	}
+
+	ModifyLobbyAttributeInternal(LocalPlayer, LobbyResult, AttrToChange, AttrToRemove, Delegate);
+	return true;
+}
+
+void UOnlineLobbySubsystem::ModifyLobbyAttributeInternal(ULocalPlayer* LocalPlayer, const ULobbyResult* LobbyResult, TSet<FLobbyAttribute> AttrToChange, TSet<FLobbyAttribute> AttrToRemove, FLobbyModifyCompleteDelegate Delegate)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	check(DevSettings);
+
+	check(LobbyResult);
+	auto LobbiesInterface{ GetLobbiesInterface(LobbyResult->GetServiceContext()) };
+	check(LobbiesInterface);
+
+	check(LocalPlayer);
+	const auto AccountId{ GetLocalAccountId(LocalPlayer, LobbyResult->GetServiceContext()) };
+	check(AccountId.IsValid());
+
+	const auto LobbyId{ LobbyResult->GetLobby()->LobbyId };
+	check(LobbyId.IsValid());
+
+	ensure(Delegate.IsBound());
+
+	// Modify Attributes
+
+	FModifyLobbyAttributes::Params Params;
+	Params.LobbyId = LobbyId;
+	Params.LocalAccountId = AccountId;
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Modify Lobby Attributes"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(Params.LocalAccountId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(Params.LobbyId));
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| ToChange[%d]"), AttrToChange.Num());
+	for (const auto& ToChange : AttrToChange)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| + (%s)[%s]"), *ToChange.GetAttributeName().ToString(), *ToChange.GetAttributeAsString());
+		Params.UpdatedAttributes.Add(DevSettings->RedirectLobbyAttribute_ToOnlineService(ToChange.GetAttributeName()), ToChange.ToSchemaVariant());
+	}
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| ToRemove[%d]"), AttrToRemove.Num());
+	for (const auto& ToRemove : AttrToRemove)
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| - (%s)"), *ToRemove.GetAttributeName().ToString());
+		Params.RemovedAttributes.Add(DevSettings->RedirectLobbyAttribute_ToOnlineService(ToRemove.GetAttributeName()));
+	}
+
+	const auto OperationKey{ BeginOperation(LobbyResult->GetLocalName(), ELobbyOperationType::Modify, const_cast<ULobbyResult*>(LobbyResult)) };
+
+	auto Handle{ LobbiesInterface->ModifyLobbyAttributes(MoveTemp(Params)) };
+	Handle.OnComplete(this, &ThisClass::HandleModifyLobbyAttributeComplete, OperationKey, LobbyResult, Delegate);
+
+	ArmOperation<FModifyLobbyAttributes>(OperationKey, Handle, [this, OperationKey, LobbyResult, Delegate](const TOnlineResult<FModifyLobbyAttributes>& Result)
+	{
+		HandleModifyLobbyAttributeComplete(Result, OperationKey, LobbyResult, Delegate);
+	});
+}
+
+void UOnlineLobbySubsystem::HandleModifyLobbyAttributeComplete(const TOnlineResult<FModifyLobbyAttributes>& ModifyResult, FLobbyOperationKey OperationKey, const ULobbyResult* LobbyResult, FLobbyModifyCompleteDelegate Delegate)
+{
+	// The modification has already been aborted
+
+	if (!OngoingOperations.Contains(OperationKey))
+	{
+		return;
+	}
+
+	EndOperation(OperationKey);
+
+	const auto bSuccess{ ModifyResult.IsOk() };
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Modify Lobby Attributes Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *ModifyResult.GetErrorValue().GetLogString());
 
 	FOnlineServiceResult ServiceResult;
 
-	if (bSuccess)
-	{
-		RemoveJoiningLobby(LocalName);
-	}
-	else
+	if (!bSuccess)
 	{
-		ServiceResult = FOnlineServiceResult(LeaveResult.GetErrorValue());
+		ServiceResult = FOnlineServiceResult(ModifyResult.GetErrorValue());
 	}
 
 	ensure(Delegate.IsBound());
-	Delegate.ExecuteIfBound(ServiceResult);
+	Delegate.ExecuteIfBound(LobbyResult, ServiceResult);
 }
 
-void UOnlineLobbySubsystem::CleanUpOngoingRequest()
+
+// Modify Lobby Attribute Queue
+
+void UOnlineLobbySubsystem::QueueLobbyAttributeModification(ULocalPlayer* LocalPlayer, const ULobbyResult* LobbyResult, const TSet<FLobbyAttribute>& AttrToChange, const TSet<FLobbyAttribute>& AttrToRemove, FLobbyModifyCompleteDelegate Delegate)
 {
-	OngoingCreateRequest = nullptr;
-	OngoingJoinRequest = nullptr;
-	OngoingSearchRequest = nullptr;
-}
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	check(DevSettings);
 
+	check(LocalPlayer);
+	check(LobbyResult);
 
-// Join Lobby Request
+	const auto LobbyId{ LobbyResult->GetLobbyId() };
+	check(LobbyId.IsValid());
 
-void UOnlineLobbySubsystem::NotifyUserJoinLobbyRequest(const FPlatformUserId& LocalPlatformUserId, ULobbyResult* RequestedLobby, FOnlineServiceResult Result)
-{
-	OnUserJoinLobbyRequest.Broadcast(LocalPlatformUserId, RequestedLobby, Result);
-	K2_OnUserJoinLobbyRequest.Broadcast(LocalPlatformUserId, RequestedLobby, Result);
-}
+	auto& Queue{ LobbyAttributeModifyQueues.FindOrAdd(LobbyId) };
+	Queue.LocalPlayer = LocalPlayer;
+	Queue.LobbyResult = LobbyResult;
+	Queue.Delegates.Emplace(Delegate);
 
+	// Merge into pending modifications, later modifications overwrite earlier ones
 
-// Lobby Member Change
+	for (const auto& ToChange : AttrToChange)
+	{
+		Queue.ToRemove.Remove(ToChange.GetAttributeName());
+		Queue.ToChange.Emplace(ToChange.GetAttributeName(), ToChange);
+	}
 
-void UOnlineLobbySubsystem::NotifyLobbyMemberChanged(FName LocalName, int32 CurrentMembers, int32 MaxMembers)
-{
-	OnLobbyMemberChanged.Broadcast(LocalName, CurrentMembers, MaxMembers);
-	K2_OnLobbyMemberChanged.Broadcast(LocalName, CurrentMembers, MaxMembers);
-}
+	for (const auto& ToRemove : AttrToRemove)
+	{
+		Queue.ToChange.Remove(ToRemove.GetAttributeName());
+		Queue.ToRemove.Emplace(ToRemove.GetAttributeName());
+	}
 
+	UE_LOG(LogGameCore_OnlineLobbies, Verbose, TEXT("Queue Lobby Attribute Modification"));
+	UE_LOG(LogGameCore_OnlineLobbies, Verbose, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+	UE_LOG(LogGameCore_OnlineLobbies, Verbose, TEXT("| Pending: +%d -%d"), Queue.ToChange.Num(), Queue.ToRemove.Num());
 
-// Lobby Leader Change
+	// Start the window at the first queued modification
 
-void UOnlineLobbySubsystem::NotifyLobbyLeaderChanged(FName LocalName)
-{
-	OnLobbyLeaderChanged.Broadcast(LocalName);
-	K2_OnLobbyLeaderChanged.Broadcast(LocalName);
+	auto& TimerManager{ GetGameInstance()->GetTimerManager() };
+
+	if (!TimerManager.IsTimerActive(Queue.FlushTimerHandle))
+	{
+		TimerManager.SetTimer(
+			Queue.FlushTimerHandle
+			, FTimerDelegate::CreateUObject(this, &ThisClass::HandleLobbyAttributeModifyDebounceExpired, LobbyId)
+			, DevSettings->GetLobbyAttributeModifyDebounceTime()
+			, false);
+	}
 }
 
-void UOnlineLobbySubsystem::NotifyLobbyBecomeLeader(FName LocalName)
+void UOnlineLobbySubsystem::HandleLobbyAttributeModifyDebounceExpired(FLobbyId LobbyId)
 {
-	OnLobbyBecomeLeader.Broadcast(LocalName);
-	K2_OnLobbyBecomeLeader.Broadcast(LocalName);
+	FlushLobbyAttributeModifyQueue(LobbyId);
 }
 
-
-// Travel Lobby
-
-bool UOnlineLobbySubsystem::TravelToLobby(APlayerController* InPlayerController, const ULobbyResult* LobbyResult)
+void UOnlineLobbySubsystem::FlushLobbyAttributeModifications(const ULobbyResult* LobbyResult)
 {
-	if (!InPlayerController)
+	if (LobbyResult)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid Player Controller"));
-		return false;
+		FlushLobbyAttributeModifyQueue(LobbyResult->GetLobbyId());
 	}
+}
 
-	auto* LocalPlayer{ InPlayerController->GetLocalPlayer() };
-	if (!LocalPlayer)
+void UOnlineLobbySubsystem::FlushAllLobbyAttributeModifications()
+{
+	TArray<FLobbyId> LobbyIds;
+	LobbyAttributeModifyQueues.GenerateKeyArray(LobbyIds);
+
+	for (const auto& LobbyId : LobbyIds)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Can't get LocalPlayer from PlayerController(%s)"), *GetNameSafe(InPlayerController));
-		return false;
+		FlushLobbyAttributeModifyQueue(LobbyId);
 	}
+}
 
-	const auto AccountId{ LocalPlayer->GetPreferredUniqueNetId().GetV2() };
-	if (!AccountId.IsValid())
+void UOnlineLobbySubsystem::FlushLobbyAttributeModifyQueue(const FLobbyId& LobbyId)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	check(DevSettings);
+
+	// Keep queuing while the previous flush is in flight, the queue is sent once it completes
+
+	if (LobbyAttributeFlushesInFlight.Contains(LobbyId))
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid AccountId from LocalPlayer(%s)"), *GetNameSafe(LocalPlayer));
-		return false;
+		return;
 	}
 
-	if (!LobbyResult)
+	FLobbyAttributeModifyQueue Queue;
+	if (!LobbyAttributeModifyQueues.RemoveAndCopyValue(LobbyId, Queue))
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid LobbyResult"));
-		return false;
+		return;
 	}
 
-	const auto URL{ LobbyResult->GetLobbyTravelURL() };
-	if (URL.IsEmpty())
+	GetGameInstance()->GetTimerManager().ClearTimer(Queue.FlushTimerHandle);
+
+	auto* LocalPlayer{ Queue.LocalPlayer.Get() };
+	const auto* LobbyResult{ Queue.LobbyResult.Get() };
+	const auto Lobby{ LobbyResult ? LobbyResult->GetLobby() : nullptr };
+
+	FString OutError;
+	if (!LocalPlayer)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: No URL in LobbyResult(%s)"), *GetNameSafe(LobbyResult));
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("If you have not joined the lobby, the URL does not exist."));
-		return false;
+		OutError = TEXT("LocalPlayer is no longer valid");
 	}
-
-	auto Lobby{ LobbyResult->GetLobby() };
-	if (!Lobby)
+	else if (!Lobby)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid Lobby in LobbyResult(%s)"), *GetNameSafe(LobbyResult));
-		return false;
+		OutError = TEXT("LobbyResult is no longer valid");
+	}
+	else
+	{
+		ValidateLobbyContext(LocalPlayer, LobbyResult->GetServiceContext(), OutError);
 	}
 
-	auto* World{ GetWorld() };
-	if (!World)
+	if (!OutError.IsEmpty())
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Travel To Lobby Failed: Invalid World"));
-		return false;
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Flush Lobby Attribute Modification Failed: %s"), *OutError);
+
+		for (const auto& Delegate : Queue.Delegates)
+		{
+			Delegate.ExecuteIfBound(LobbyResult, FOnlineServiceResult(Errors::InvalidState()));
+		}
+
+		return;
 	}
 
-	// Start Travel
+	// Drop modifications that would not change the current attributes of the lobby
 
-	const auto bIsHost{ Lobby->OwnerAccountId == AccountId };
+	TSet<FLobbyAttribute> AttrToChange;
+	TSet<FLobbyAttribute> AttrToRemove;
+	AttrToChange.Reserve(Queue.ToChange.Num());
+	AttrToRemove.Reserve(Queue.ToRemove.Num());
 
-	if (bIsHost)
+	for (auto& KVP : Queue.ToChange)
 	{
-		return World->ServerTravel(URL);
+		const auto* CurrentValue{ Lobby->Attributes.Find(DevSettings->RedirectLobbyAttribute_ToOnlineService(KVP.Key)) };
+
+		if (!CurrentValue || !(*CurrentValue == KVP.Value.ToSchemaVariant()))
+		{
+			AttrToChange.Emplace(MoveTemp(KVP.Value));
+		}
 	}
-	else
+
+	for (const auto& Name : Queue.ToRemove)
 	{
-		InPlayerController->ClientTravel(URL, TRAVEL_Absolute);
-		return true;
+		if (Lobby->Attributes.Contains(DevSettings->RedirectLobbyAttribute_ToOnlineService(Name)))
+		{
+			AttrToRemove.Emplace(FLobbyAttribute(Name));
+		}
+	}
+
+	if (AttrToChange.IsEmpty() && AttrToRemove.IsEmpty())
+	{
+		for (const auto& Delegate : Queue.Delegates)
+		{
+			Delegate.ExecuteIfBound(LobbyResult, FOnlineServiceResult());
+		}
+
+		return;
 	}
+
+	// Notify all callers merged into this modification, then send what has been queued in the meantime
+
+	auto CombinedDelegate
+	{
+		FLobbyModifyCompleteDelegate::CreateWeakLambda(this,
+			[this, LobbyId, Delegates = MoveTemp(Queue.Delegates)](const ULobbyResult* InLobbyResult, FOnlineServiceResult InResult)
+			{
+				LobbyAttributeFlushesInFlight.Remove(LobbyId);
+
+				for (const auto& Delegate : Delegates)
+				{
+					Delegate.ExecuteIfBound(InLobbyResult, InResult);
+				}
+
+				const auto* PendingQueue{ LobbyAttributeModifyQueues.Find(LobbyId) };
+				if (PendingQueue && !GetGameInstance()->GetTimerManager().IsTimerActive(PendingQueue->FlushTimerHandle))
+				{
+					FlushLobbyAttributeModifyQueue(LobbyId);
+				}
+			})
+	};
+
+	LobbyAttributeFlushesInFlight.Emplace(LobbyId);
+
+	ModifyLobbyAttributeInternal(LocalPlayer, LobbyResult, MoveTemp(AttrToChange), MoveTemp(AttrToRemove), CombinedDelegate);
 }
 
 
-// Modify Lobby
+// Modify Lobby Transaction
 
-bool UOnlineLobbySubsystem::ModifyLobbyJoinPolicy(APlayerController* InPlayerController, const ULobbyResult* LobbyResult, ELobbyJoinablePolicy NewPolicy, FLobbyModifyCompleteDelegate Delegate)
+ULobbyModifyTransaction* UOnlineLobbySubsystem::CreateLobbyModifyTransaction()
+{
+	auto* NewTransaction{ NewObject<ULobbyModifyTransaction>(this) };
+	return NewTransaction;
+}
+
+bool UOnlineLobbySubsystem::CommitLobbyModifyTransaction(APlayerController* InPlayerController, const ULobbyResult* LobbyResult, ULobbyModifyTransaction* Transaction, FLobbyModifyCompleteDelegate Delegate)
 {
 	if (!InPlayerController)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Invalid Player Controller"));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Commit Transaction Failed: Invalid Player Controller"));
 		return false;
 	}
 
 	auto* LocalPlayer{ InPlayerController->GetLocalPlayer() };
 	if (!LocalPlayer)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Can't get LocalPlayer from PlayerController(%s)"), *GetNameSafe(InPlayerController));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Commit Transaction Failed: Can't get LocalPlayer from PlayerController(%s)"), *GetNameSafe(InPlayerController));
 		return false;
 	}
 
-	const auto AccountId{ LocalPlayer->GetPreferredUniqueNetId().GetV2() };
-	if (!AccountId.IsValid())
+	if (!LobbyResult || !LobbyResult->GetLobby())
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Invalid AccountId from LocalPlayer(%s)"), *GetNameSafe(LocalPlayer));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Commit Transaction Failed: Invalid LobbyResult"));
 		return false;
 	}
 
-	if (!LobbyResult)
+	if (!Transaction)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Invalid LobbyResult"));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Commit Transaction Failed: Invalid Transaction"));
 		return false;
 	}
 
-	auto Lobby{ LobbyResult->GetLobby() };
-	if (!Lobby)
+	FString OutError;
+	if (!Transaction->ValidateAndLogErrors(OutError))
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Join Policy Failed: Invalid Lobby in LobbyResult(%s)"), *GetNameSafe(LobbyResult));
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Commit Transaction Failed: %s"), *OutError);
 		return false;
 	}
 
-	ModifyLobbyJoinPolicyInternal(LocalPlayer, LobbyResult, NewPolicy, Delegate);
+	if (!ValidateLobbyContext(LocalPlayer, LobbyResult->GetServiceContext(), OutError))
+	{
+		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Commit Transaction Failed: %s"), *OutError);
+		return false;
+	}
+
+	CommitLobbyModifyTransactionInternal(LocalPlayer, LobbyResult, Transaction, Delegate);
 	return true;
 }
 
-void UOnlineLobbySubsystem::ModifyLobbyJoinPolicyInternal(ULocalPlayer* LocalPlayer, const ULobbyResult* LobbyResult, ELobbyJoinablePolicy NewPolicy, FLobbyModifyCompleteDelegate Delegate)
+void UOnlineLobbySubsystem::CommitLobbyModifyTransactionInternal(ULocalPlayer* LocalPlayer, const ULobbyResult* LobbyResult, ULobbyModifyTransaction* Transaction, FLobbyModifyCompleteDelegate Delegate)
 {
-	auto LobbiesInterface{ GetLobbiesInterface() };
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+	check(DevSettings);
+
+	check(LobbyResult);
+	auto LobbiesInterface{ GetLobbiesInterface(LobbyResult->GetServiceContext()) };
 	check(LobbiesInterface);
 
 	check(LocalPlayer);
-	const auto AccountId{ LocalPlayer->GetPreferredUniqueNetId().GetV2() };
+	const auto AccountId{ GetLocalAccountId(LocalPlayer, LobbyResult->GetServiceContext()) };
 	check(AccountId.IsValid());
 
-	check(LobbyResult);
 	const auto LobbyId{ LobbyResult->GetLobby()->LobbyId };
 	check(LobbyId.IsValid());
 
-	ensure(Delegate.IsBound());
-	
-	// Modify Join Policy
+	check(Transaction);
 
-	FModifyLobbyJoinPolicy::Params Params;
-	Params.JoinPolicy = static_cast<ELobbyJoinPolicy>(NewPolicy);
-	Params.LocalAccountId = AccountId;
-	Params.LobbyId = LobbyId;
-	
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Modify Lobby Join Plocy"));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(Params.LocalAccountId));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(Params.LobbyId));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Policy: %s"), *StaticEnum<ELobbyJoinablePolicy>()->GetValueAsString(NewPolicy));
+	auto State{ MakeShared<FLobbyModifyTransactionState>() };
+	State->LobbyResult = LobbyResult;
+	State->Delegates.Emplace(Delegate);
 
-	auto Handle{ LobbiesInterface->ModifyLobbyJoinPolicy(MoveTemp(Params)) };
-	Handle.OnComplete(this, &ThisClass::HandleModifyLobbyJoinPolicyComplete, LobbyResult, Delegate);
-}
+	// Build attribute modifications
 
-void UOnlineLobbySubsystem::HandleModifyLobbyJoinPolicyComplete(const TOnlineResult<FModifyLobbyJoinPolicy>& ModifyResult, const ULobbyResult* LobbyResult, FLobbyModifyCompleteDelegate Delegate)
-{
-	if (ModifyResult.IsOk())
+	FModifyLobbyAttributes::Params AttrParams;
+	AttrParams.LobbyId = LobbyId;
+	AttrParams.LocalAccountId = AccountId;
+
+	for (const auto& ToChange : Transaction->AttrToChange)
 	{
-		const auto bSuccess{ ModifyResult.IsOk() };
+		AttrParams.UpdatedAttributes.Add(DevSettings->RedirectLobbyAttribute_ToOnlineService(ToChange.GetAttributeName()), ToChange.ToSchemaVariant());
+	}
 
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Modify Lobby Join Plocy Completed"));
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *ModifyResult.GetErrorValue().GetLogString());
+	for (const auto& ToRemove : Transaction->AttrToRemove)
+	{
+		AttrParams.RemovedAttributes.Add(DevSettings->RedirectLobbyAttribute_ToOnlineService(ToRemove.GetAttributeName()));
+	}
 
-		FOnlineServiceResult ServiceResult;
+	// Take over modifications still waiting in the queue of this lobby, the transaction takes priority
 
-		if (!bSuccess)
+	FLobbyAttributeModifyQueue Queue;
+	if (LobbyAttributeModifyQueues.RemoveAndCopyValue(LobbyId, Queue))
+	{
+		GetGameInstance()->GetTimerManager().ClearTimer(Queue.FlushTimerHandle);
+
+		for (auto& KVP : Queue.ToChange)
 		{
-			ServiceResult = FOnlineServiceResult(ModifyResult.GetErrorValue());
+			const auto ServiceName{ DevSettings->RedirectLobbyAttribute_ToOnlineService(KVP.Key) };
+
+			if (!AttrParams.UpdatedAttributes.Contains(ServiceName) && !AttrParams.RemovedAttributes.Contains(ServiceName))
+			{
+				AttrParams.UpdatedAttributes.Add(ServiceName, MoveTemp(KVP.Value).ToSchemaVariant());
+			}
 		}
 
-		ensure(Delegate.IsBound());
-		Delegate.ExecuteIfBound(LobbyResult, ServiceResult);
-	}
-}
+		for (const auto& Name : Queue.ToRemove)
+		{
+			const auto ServiceName{ DevSettings->RedirectLobbyAttribute_ToOnlineService(Name) };
 
+			if (!AttrParams.UpdatedAttributes.Contains(ServiceName))
+			{
+				AttrParams.RemovedAttributes.Add(ServiceName);
+			}
+		}
 
-bool UOnlineLobbySubsystem::ModifyLobbyAttribute(APlayerController* InPlayerController, const ULobbyResult* LobbyResult, TSet<FLobbyAttribute> AttrToChange, TSet<FLobbyAttribute> AttrToRemove, FLobbyModifyCompleteDelegate Delegate)
-{
-	if (!InPlayerController)
-	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Invalid Player Controller"));
-		return false;
+		State->Delegates.Append(MoveTemp(Queue.Delegates));
 	}
 
-	auto* LocalPlayer{ InPlayerController->GetLocalPlayer() };
-	if (!LocalPlayer)
+	// Build member attribute modifications
+
+	FModifyLobbyMemberAttributes::Params MemberAttrParams;
+	MemberAttrParams.LobbyId = LobbyId;
+	MemberAttrParams.LocalAccountId = AccountId;
+
+	for (const auto& ToChange : Transaction->MemberAttrToChange)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Can't get LocalPlayer from PlayerController(%s)"), *GetNameSafe(InPlayerController));
-		return false;
+		MemberAttrParams.UpdatedAttributes.Add(DevSettings->RedirectUserLobbyAttribute_ToOnlineService(ToChange.GetAttributeName()), ToChange.ToSchemaVariant());
 	}
 
-	const auto AccountId{ LocalPlayer->GetPreferredUniqueNetId().GetV2() };
-	if (!AccountId.IsValid())
+	for (const auto& ToRemove : Transaction->MemberAttrToRemove)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Invalid AccountId from LocalPlayer(%s)"), *GetNameSafe(LocalPlayer));
-		return false;
+		MemberAttrParams.RemovedAttributes.Add(DevSettings->RedirectUserLobbyAttribute_ToOnlineService(ToRemove.GetAttributeName()));
 	}
 
-	if (!LobbyResult)
+	const auto bModifyJoinPolicy{ Transaction->bChangeJoinPolicy };
+	const auto bModifyAttributes{ !AttrParams.UpdatedAttributes.IsEmpty() || !AttrParams.RemovedAttributes.IsEmpty() };
+	const auto bModifyMemberAttributes{ !MemberAttrParams.UpdatedAttributes.IsEmpty() || !MemberAttrParams.RemovedAttributes.IsEmpty() };
+
+	State->NumPending = (bModifyJoinPolicy ? 1 : 0) + (bModifyAttributes ? 1 : 0) + (bModifyMemberAttributes ? 1 : 0);
+
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Commit Lobby Modify Transaction"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(AccountId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(LobbyId));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Policy: %s"), bModifyJoinPolicy ? *StaticEnum<ELobbyJoinablePolicy>()->GetValueAsString(Transaction->NewJoinPolicy) : TEXT("Unchanged"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Attributes: +%d -%d"), AttrParams.UpdatedAttributes.Num(), AttrParams.RemovedAttributes.Num());
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| MemberAttributes: +%d -%d"), MemberAttrParams.UpdatedAttributes.Num(), MemberAttrParams.RemovedAttributes.Num());
+
+	// Start all backend calls at the same time
+
+	const auto LocalName{ LobbyResult->GetLocalName() };
+
+	if (bModifyJoinPolicy)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Invalid LobbyResult"));
-		return false;
+		FModifyLobbyJoinPolicy::Params PolicyParams;
+		PolicyParams.JoinPolicy = static_cast<ELobbyJoinPolicy>(Transaction->NewJoinPolicy);
+		PolicyParams.LocalAccountId = AccountId;
+		PolicyParams.LobbyId = LobbyId;
+
+		StartLobbyModifyTransactionStep<FModifyLobbyJoinPolicy>(LocalName, Transaction, LobbiesInterface->ModifyLobbyJoinPolicy(MoveTemp(PolicyParams)), State);
 	}
 
-	auto Lobby{ LobbyResult->GetLobby() };
-	if (!Lobby)
+	if (bModifyAttributes)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: Invalid Lobby in LobbyResult(%s)"), *GetNameSafe(LobbyResult));
-		return false;
+		StartLobbyModifyTransactionStep<FModifyLobbyAttributes>(LocalName, Transaction, LobbiesInterface->ModifyLobbyAttributes(MoveTemp(AttrParams)), State);
 	}
 
-	if (AttrToChange.IsEmpty() && AttrToRemove.IsEmpty())
+	if (bModifyMemberAttributes)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Modify Attribute Failed: No Attributes should be modified"));
-		return false;
+		StartLobbyModifyTransactionStep<FModifyLobbyMemberAttributes>(LocalName, Transaction, LobbiesInterface->ModifyLobbyMemberAttributes(MoveTemp(MemberAttrParams)), State);
 	}
-
-	ModifyLobbyAttributeInternal(LocalPlayer, LobbyResult, AttrToChange, AttrToRemove, Delegate);
-	return true;
 }
 
-void UOnlineLobbySubsystem::ModifyLobbyAttributeInternal(ULocalPlayer* LocalPlayer, const ULobbyResult* LobbyResult, TSet<FLobbyAttribute> AttrToChange, TSet<FLobbyAttribute> AttrToRemove, FLobbyModifyCompleteDelegate Delegate)
+template<typename OpType>
+void UOnlineLobbySubsystem::StartLobbyModifyTransactionStep(FName LocalName, ULobbyModifyTransaction* Transaction, TOnlineAsyncOpHandle<OpType> Handle, TSharedRef<FLobbyModifyTransactionState> State)
 {
-	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
-	check(DevSettings);
-
-	auto LobbiesInterface{ GetLobbiesInterface() };
-	check(LobbiesInterface);
+	const auto OperationKey{ BeginOperation(LocalName, ELobbyOperationType::Modify, Transaction) };
 
-	check(LocalPlayer);
-	const auto AccountId{ LocalPlayer->GetPreferredUniqueNetId().GetV2() };
-	check(AccountId.IsValid());
-
-	check(LobbyResult);
-	const auto LobbyId{ LobbyResult->GetLobby()->LobbyId };
-	check(LobbyId.IsValid());
+	Handle.OnComplete(this, &ThisClass::HandleLobbyModifyTransactionStepComplete<OpType>, OperationKey, State);
 
-	ensure(Delegate.IsBound());
+	ArmOperation<OpType>(OperationKey, Handle, [this, OperationKey, State](const TOnlineResult<OpType>& Result)
+	{
+		HandleLobbyModifyTransactionStepComplete<OpType>(Result, OperationKey, State);
+	});
+}
 
-	// Modify Attributes
+template<typename OpType>
+void UOnlineLobbySubsystem::HandleLobbyModifyTransactionStepComplete(const TOnlineResult<OpType>& StepResult, FLobbyOperationKey OperationKey, TSharedRef<FLobbyModifyTransactionState> State)
+{
+	// The step has already been aborted
 
-	FModifyLobbyAttributes::Params Params;
-	Params.LobbyId = LobbyId;
-	Params.LocalAccountId = AccountId;
+	if (!OngoingOperations.Contains(OperationKey))
+	{
+		return;
+	}
 
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Modify Lobby Attributes"));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| AccountId: %s"), *ToLogString(Params.LocalAccountId));
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| LobbyId: %s"), *ToLogString(Params.LobbyId));
+	EndOperation(OperationKey);
 
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| ToChange[%d]"), AttrToChange.Num());
-	for (const auto& ToChange : AttrToChange)
+	if (StepResult.IsError() && State->Result.bWasSuccessful)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| + (%s)[%s]"), *ToChange.GetAttributeName().ToString(), *ToChange.GetAttributeAsString());
-		Params.UpdatedAttributes.Add(DevSettings->RedirectLobbyAttribute_ToOnlineService(ToChange.GetAttributeName()), ToChange.ToSchemaVariant());
+		State->Result = FOnlineServiceResult(StepResult.GetErrorValue());
 	}
 
-	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| ToRemove[%d]"), AttrToRemove.Num());
-	for (const auto& ToRemove : AttrToRemove)
+	if (--State->NumPending > 0)
 	{
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| - (%s)"), *ToRemove.GetAttributeName().ToString());
-		Params.RemovedAttributes.Add(DevSettings->RedirectLobbyAttribute_ToOnlineService(ToRemove.GetAttributeName()));
+		return;
 	}
 
-	auto Handle{ LobbiesInterface->ModifyLobbyAttributes(MoveTemp(Params)) };
-	Handle.OnComplete(this, &ThisClass::HandleModifyLobbyAttributeComplete, LobbyResult, Delegate);
-}
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Lobby Modify Transaction Completed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), State->Result.bWasSuccessful ? TEXT("Success") : TEXT("Failed"));
+	UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), *State->Result.ErrorId);
 
-void UOnlineLobbySubsystem::HandleModifyLobbyAttributeComplete(const TOnlineResult<FModifyLobbyAttributes>& ModifyResult, const ULobbyResult* LobbyResult, FLobbyModifyCompleteDelegate Delegate)
-{
-	if (ModifyResult.IsOk())
+	for (const auto& Delegate : State->Delegates)
 	{
-		const auto bSuccess{ ModifyResult.IsOk() };
-
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("Modify Lobby Attributes Completed"));
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
-		UE_LOG(LogGameCore_OnlineLobbies, Log, TEXT("| Error: %s"), bSuccess ? TEXT("") : *ModifyResult.GetErrorValue().GetLogString());
-
-		FOnlineServiceResult ServiceResult;
-
-		if (!bSuccess)
-		{
-			ServiceResult = FOnlineServiceResult(ModifyResult.GetErrorValue());
-		}
-
-		ensure(Delegate.IsBound());
-		Delegate.ExecuteIfBound(LobbyResult, ServiceResult);
+		Delegate.ExecuteIfBound(State->LobbyResult.Get(), State->Result);
 	}
 }
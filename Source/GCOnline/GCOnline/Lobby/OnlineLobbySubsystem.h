@@ -9,10 +9,17 @@
 #include "Type/OnlineLobbyCreateTypes.h"
 #include "Type/OnlineLobbyJoinTypes.h"
 #include "Type/OnlineLobbySearchTypes.h"
+#include "Type/OnlineLobbyModifyTypes.h"
+#include "Type/OnlineLobbyRosterTypes.h"
+#include "Type/OnlineLobbyRankingTypes.h"
+#include "Type/OnlineLobbyBlacklistTypes.h"
+#include "Type/OnlineLobbyOperationTypes.h"
 
 // OSSv2
 #include "Online/OnlineAsyncOpHandle.h"
 
+#include "UObject/StrongObjectPtr.h"
+
 #include "OnlineLobbySubsystem.generated.h"
 
 ///////////////////////////////////////////////////
@@ -30,6 +37,7 @@ using namespace UE::Online;
 
 class UOnlineServiceSubsystem;
 class ULobbyResult;
+struct FStreamableHandle;
 
 ///////////////////////////////////////////////////
 
@@ -48,6 +56,20 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FLobbyMemberChangedDynamicDelegat
     , int32, MaxMembers);
 
 
+/**
+ * Event triggered when members have joined or left the lobby, or their attributes have changed.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FLobbyRosterChangedDelegate, const FLobbyRosterDelta& /* Delta */);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLobbyRosterChangedDynamicDelegate, const FLobbyRosterDelta&, Delta);
+
+
+/**
+ * Event triggered when lobby or member attributes have been added, changed or removed.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FLobbyAttributesChangedDelegate, const FLobbyAttributeChanges& /* Changes */);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLobbyAttributesChangedDynamicDelegate, const FLobbyAttributeChanges&, Changes);
+
+
 /**
  * Event triggered when Lobby leaders have changed.
  */
@@ -114,22 +136,161 @@ protected:
      */
     ILobbiesPtr GetLobbiesInterface(EOnlineServiceContext Context = EOnlineServiceContext::Default) const;
 
+    /**
+     * Returns the contexts that have their own online service, the default context is always first
+     */
+    TArray<EOnlineServiceContext> GetAvailableServiceContexts() const;
+
+    /**
+     * Returns the account id of the local player on the online service of the context
+     */
+    FAccountId GetLocalAccountId(const ULocalPlayer* LocalPlayer, EOnlineServiceContext Context = EOnlineServiceContext::Default) const;
+
+    /**
+     * Returns false if the context has no lobbies interface or the local player is not signed in on it
+     */
+    bool ValidateLobbyContext(const ULocalPlayer* LocalPlayer, EOnlineServiceContext Context, FString& OutError) const;
+
 
     //////////////////////////////////////////////////////////////////////
     // Lobby Events
 protected:
-    void HandleUserJoinLobbyRequest(const FUILobbyJoinRequested& EventParams);
+    void HandleUserJoinLobbyRequest(const FUILobbyJoinRequested& EventParams, EOnlineServiceContext Context);
+    void HandleLobbyJoined(const FLobbyJoined& EventParams);
+    void HandleLobbyLeft(const FLobbyLeft& EventParams);
     void HandleLobbyMemberJoined(const FLobbyMemberJoined& EventParams);
     void HandleLobbyMemberLeft(const FLobbyMemberLeft& EventParams);
+    void HandleLobbyAttributesChanged(const FLobbyAttributesChanged& EventParams);
+    void HandleLobbyMemberAttributesChanged(const FLobbyMemberAttributesChanged& EventParams);
     void HandleLobbyLeaderChanged(const FLobbyLeaderChanged& EventParams);
 
 
     //////////////////////////////////////////////////////////////////////
-    // Create Lobby
+    // Ongoing Operations
 protected:
+    //
+    // List of lobby operations currently in progress
+    // 
+    // Key   : Lobby's Local Name and operation id
+    // Value : Operation info
+    //
     UPROPERTY(Transient)
-    TObjectPtr<ULobbyCreateRequest> OngoingCreateRequest{ nullptr };
+    TMap<FLobbyOperationKey, FLobbyOperation> OngoingOperations;
+
+    //
+    // Id assigned to the most recently started operation
+    //
+    int32 LastOperationId{ 0 };
+
+    //
+    // Create and join operations that ended before the online service completed them
+    // 
+    // Tips:
+    //	If the online service still completes one of them successfully, the lobby is left as soon as the result arrives.
+    //
+    TSet<FLobbyOperationKey> AbortedOperations;
+
+protected:
+    /**
+     * Registers a new operation in progress and returns the key to find it on completion
+     */
+    FLobbyOperationKey BeginOperation(FName LocalName, ELobbyOperationType Type, UObject* Request);
+
+    /**
+     * Removes the operation from the list of operations in progress
+     */
+    void EndOperation(const FLobbyOperationKey& Key);
+
+    /**
+     * Returns the request object of the operation in progress, will return null if the operation has already ended
+     */
+    template<typename T>
+    T* GetOperationRequest(const FLobbyOperationKey& Key) const
+    {
+        const auto* Operation{ OngoingOperations.Find(Key) };
+        return Operation ? Cast<T>(Operation->Request) : nullptr;
+    }
+
+    /**
+     * Returns true if an operation of the type is in progress for the lobby with the local name
+     */
+    bool HasOngoingOperation(FName LocalName, ELobbyOperationType Type) const;
+
+    /**
+     * Sets how the operation is aborted and starts its deadline if a timeout is set in the developer settings
+     * 
+     * Tips:
+     *	The operation is aborted by passing the error to its completion handler, and then cancelling the operation of the online service.
+     *	The handler ends the operation, so the late completion from the online service is ignored.
+     */
+    template<typename OpType>
+    void ArmOperation(const FLobbyOperationKey& Key, TOnlineAsyncOpHandle<OpType> Handle, TFunction<void(const TOnlineResult<OpType>&)>&& Complete)
+    {
+        auto* Operation{ OngoingOperations.Find(Key) };
+        if (!Operation)
+        {
+            return;
+        }
+
+        Operation->Abort = [Handle, Complete = MoveTemp(Complete)](const FOnlineError& Error) mutable
+        {
+            Complete(TOnlineResult<OpType>(Error));
+            Handle.Cancel();
+        };
+
+        ScheduleOperationDeadline(Key, *Operation);
+    }
+
+    /**
+     * Completes the operation in progress with the error and cancels it, returns false if the operation has already ended
+     */
+    bool AbortOperation(const FLobbyOperationKey& Key, const FOnlineError& Error);
 
+public:
+    /**
+     * Cancels the create, search or join started with the request, the operation completes with a cancelled result
+     * 
+     * Tips:
+     *	Cancelling a search that other callers are attached to cancels it for them as well.
+     *	Modifications and leaves in progress are cancelled with the lobby result, and committed transactions with the transaction.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual bool CancelLobbyOperation(UObject* Request);
+
+    // ==== Deadline Wheel ===
+protected:
+    //
+    // Number of slots in the deadline wheel, deadlines further than one turn away stay in their slot for multiple turns
+    //
+    static constexpr int32 DeadlineWheelSize{ 64 };
+
+    struct FLobbyDeadlineEntry
+    {
+        FLobbyOperationKey Key;
+        int64 ExpiryTick{ 0 };
+    };
+
+    //
+    // Deadlines of the operations in progress, bucketed by the tick at which they expire
+    // 
+    // Tips:
+    //	Entries of operations that have already ended are dropped when their slot is reached.
+    //
+    TStaticArray<TArray<FLobbyDeadlineEntry>, DeadlineWheelSize> DeadlineWheel;
+
+    int64 DeadlineWheelTick{ 0 };
+    int32 NumDeadlineEntries{ 0 };
+
+    FTimerHandle DeadlineWheelTimerHandle;
+
+protected:
+    void ScheduleOperationDeadline(const FLobbyOperationKey& Key, FLobbyOperation& Operation);
+
+    void HandleDeadlineWheelTick();
+
+
+    //////////////////////////////////////////////////////////////////////
+    // Create Lobby
 public:
     UPROPERTY(BlueprintAssignable, Category = "Lobby", meta = (DisplayName = "On Lobby Create Complete"))
     FLobbyCreateCompleteDynamicDelegate K2_OnLobbyCreateComplete;
@@ -154,18 +315,70 @@ protected:
     void CreateOnlineLobbyInternal(
         ULocalPlayer* LocalPlayer
         , ULobbyCreateRequest* CreateRequest
-        , FLobbyCreateCompleteDelegate Delegate = FLobbyCreateCompleteDelegate());
+        , FLobbyCreateCompleteDelegate Delegate = FLobbyCreateCompleteDelegate()
+        , bool bBroadcastComplete = true);
 
     virtual void HandleCreateOnlineLobbyComplete(
         const TOnlineResult<FCreateLobby>& CreateResult
+        , FLobbyOperationKey OperationKey
+        , FAccountId CreatingAccountId
         , FLobbyCreateCompleteDelegate Delegate);
 
+    void BroadcastLobbyCreateComplete(ULobbyCreateRequest* CreateRequest, const FOnlineServiceResult& Result);
+
 
     //////////////////////////////////////////////////////////////////////
     // Search Lobby 
 protected:
-	UPROPERTY(Transient)
-    TObjectPtr<ULobbySearchRequest> OngoingSearchRequest{ nullptr };
+    /**
+     * Lobby snapshots found by a previous search, kept to serve equivalent searches without a round trip
+     */
+    struct FLobbySearchCacheEntry
+    {
+    public:
+        FLobbySearchCacheEntry() = default;
+        ~FLobbySearchCacheEntry() = default;
+
+    public:
+        //
+        // Lobbies found by the search
+        //
+        TArray<TSharedRef<const FLobby>> Lobbies;
+
+        //
+        // Time when the search completed
+        //
+        double CachedTime{ 0.0 };
+
+        //
+        // Time when the entry was last served, used to evict least recently used entries
+        //
+        double LastAccessTime{ 0.0 };
+
+        //
+        // Approximate memory retained by the lobby snapshots
+        //
+        SIZE_T EstimatedSize{ 0 };
+
+        //
+        // Canonical search parameters and local user of the search, compared on lookup since the key is only a hash
+        //
+        FString SearchKey;
+        FAccountId SearchAccountId;
+    };
+
+    //
+    // Cached results of completed searches
+    // 
+    // Key   : Hash of the search request and local user (see GetSearchCoalescingHash)
+    // Value : Cached search result
+    //
+    TMap<uint32, FLobbySearchCacheEntry> SearchResultCache;
+
+    //
+    // Approximate memory retained by all cached search results
+    //
+    SIZE_T SearchResultCacheSize{ 0 };
 
 public:
     /**
@@ -188,10 +401,133 @@ protected:
         , ULobbySearchRequest* SearchRequest
         , FLobbySearchCompleteDelegate Delegate = FLobbySearchCompleteDelegate());
 
+    /**
+     * Starts FindLobbies or attaches to an equivalent search in progress, without looking up the cache
+     */
+    void StartSearchOnlineLobby(
+        ULocalPlayer* LocalPlayer
+        , ULobbySearchRequest* SearchRequest
+        , uint32 CanonicalHash
+        , FLobbySearchCompleteDelegate Delegate);
+
     virtual void HandleSearchOnlineLobbyComplete(
         const TOnlineResult<FFindLobbies>& SearchResult
+        , FLobbyOperationKey OperationKey
         , FLobbySearchCompleteDelegate Delegate);
 
+    /**
+     * Returns the search in progress with the same parameters and local user, will return null if there is none
+     */
+    FLobbyOperation* FindCoalescableSearch(uint32 SearchHash, const FString& SearchKey, const FAccountId& SearchAccountId);
+
+    /**
+     * Returns the hash used to coalesce and cache searches with equivalent parameters from the same local user
+     */
+    uint32 GetSearchCoalescingHash(const ULocalPlayer* LocalPlayer, uint32 CanonicalHash) const;
+
+    /**
+     * Fills the results of the search request with the lobbies found
+     */
+    virtual void ApplySearchResults(ULobbySearchRequest* SearchRequest, const TArray<TSharedRef<const FLobby>>& InLobbies);
+
+    // ==== Multi Context ===
+protected:
+    //
+    // Search running in one context as part of a search across all contexts
+    //
+    struct FLobbyContextSearch
+    {
+        EOnlineServiceContext Context{ EOnlineServiceContext::Default };
+
+        //
+        // Copy of the original request that runs in the context
+        //
+        TStrongObjectPtr<ULobbySearchRequest> Request;
+
+        FOnlineServiceResult Result;
+
+        bool bCompleted{ false };
+
+        FTimerHandle DeadlineHandle;
+    };
+
+    //
+    // State shared by the searches of each context
+    //
+    struct FLobbyMultiContextSearchState
+    {
+        TStrongObjectPtr<ULobbySearchRequest> Request;
+
+        TArray<FLobbyContextSearch> Searches;
+
+        FLobbySearchCompleteDelegate Delegate;
+
+        bool bCompleted{ false };
+    };
+
+public:
+    /**
+     * Searches lobbies in all available service contexts at the same time and merges the results
+     * 
+     * Tips:
+     *	Lobbies found in multiple contexts are listed once, for the first context in GetAvailableServiceContexts order.
+     *	Each result is tagged with the context it was found in.
+     *	Completes when all contexts have completed or reached ContextSearchDeadline of the request.
+     */
+    virtual bool SearchLobbyInAllContexts(
+        APlayerController* SearchingPlayer
+        , ULobbySearchRequest* SearchRequest
+        , FLobbySearchCompleteDelegate Delegate = FLobbySearchCompleteDelegate());
+
+protected:
+    void HandleContextSearchComplete(
+        ULobbySearchRequest* ContextRequest
+        , FOnlineServiceResult Result
+        , TSharedRef<FLobbyMultiContextSearchState> State
+        , int32 SearchIndex);
+
+    void HandleContextSearchDeadline(TSharedRef<FLobbyMultiContextSearchState> State, int32 SearchIndex);
+
+    /**
+     * Merges the results of all contexts into the original request and notifies it, does nothing if a context is still searching
+     */
+    void TryCompleteMultiContextSearch(TSharedRef<FLobbyMultiContextSearchState> State);
+
+public:
+    /**
+     * Discards all cached lobby search results
+     */
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual void ClearLobbySearchCache();
+
+protected:
+    /**
+     * Serves the search from the cache if there is a usable entry, returns false if the search should be performed
+     */
+    bool TrySearchFromCache(
+        ULocalPlayer* LocalPlayer
+        , ULobbySearchRequest* SearchRequest
+        , uint32 CanonicalHash
+        , FLobbySearchCompleteDelegate Delegate);
+
+    void HandleSearchServedFromCache(
+        TWeakObjectPtr<ULobbySearchRequest> SearchRequest
+        , FLobbySearchCompleteDelegate Delegate);
+
+    void StoreSearchResultCache(
+        uint32 SearchHash
+        , const FString& SearchKey
+        , const FAccountId& SearchAccountId
+        , const TArray<TSharedRef<const FLobby>>& Lobbies);
+    void RemoveSearchResultCache(uint32 SearchHash);
+
+    /**
+     * Evicts expired entries and least recently used entries until the cache fits the memory budget
+     */
+    void TrimSearchResultCache();
+
+    static SIZE_T EstimateLobbyMemorySize(const FLobby& Lobby);
+
 
     //////////////////////////////////////////////////////////////////////
     // Join Lobby
@@ -205,9 +541,6 @@ protected:
     UPROPERTY(Transient)
     TMap<FName, TObjectPtr<ULobbyResult>> JoiningLobbies;
 
-    UPROPERTY(Transient)
-    TObjectPtr<ULobbyJoinRequest> OngoingJoinRequest{ nullptr };
-
 public:
     UPROPERTY(BlueprintAssignable, Category = "Lobby", meta = (DisplayName = "On Lobby Join Complete"))
     FLobbyJoinCompleteDynamicDelegate K2_OnLobbyJoinComplete;
@@ -245,17 +578,235 @@ protected:
     void JoinOnlineLobbyInternal(
         ULocalPlayer* LocalPlayer
         , ULobbyJoinRequest* JoinRequest
-        , FLobbyJoinCompleteDelegate Delegate = FLobbyJoinCompleteDelegate());
+        , FLobbyJoinCompleteDelegate Delegate = FLobbyJoinCompleteDelegate()
+        , bool bBroadcastComplete = true);
 
     virtual void HandleJoinOnlineLobbyComplete(
         const TOnlineResult<FJoinLobby>& JoinResult
+        , FLobbyOperationKey OperationKey
         , FAccountId JoiningAccountId
+        , EOnlineServiceContext Context
         , FLobbyJoinCompleteDelegate Delegate);
 
+    void BroadcastLobbyJoinComplete(ULobbyJoinRequest* JoinRequest, const FOnlineServiceResult& Result);
+
     /**
      * Create a URL for lobby travel to a joined lobby
      */
-    FString ConstructJoiningLobbyTravelURL(const FAccountId& AccountId, const FLobbyId& LobbyId);
+    FString ConstructJoiningLobbyTravelURL(const FAccountId& AccountId, const FLobbyId& LobbyId, EOnlineServiceContext Context = EOnlineServiceContext::Default);
+
+
+    //////////////////////////////////////////////////////////////////////
+    // Local Users Lobby
+protected:
+    //
+    // State shared by the operations of all local users joining the same lobby
+    //
+    struct FLocalUsersLobbyBatch
+    {
+        FName LocalName;
+        FLobbyId LobbyId;
+        EOnlineServiceContext Context{ EOnlineServiceContext::Default };
+        bool bPresenceEnabled{ true };
+
+        //
+        // Account of the primary user, the lobby is left with this account when the batch is rolled back
+        //
+        FAccountId PrimaryAccountId;
+
+        TWeakObjectPtr<ULobbyJoinRequest> JoinRequest;
+        TWeakObjectPtr<ULobbyCreateRequest> CreateRequest;
+
+        FLobbyJoinCompleteDelegate JoinDelegate;
+        FLobbyCreateCompleteDelegate CreateDelegate;
+
+        //
+        // Local users other than the primary user, who joins or creates the lobby through the normal operation
+        //
+        TArray<FAccountId> MemberAccountIds;
+        TArray<FAccountId> JoinedMemberAccountIds;
+
+        bool bPrimaryJoined{ false };
+
+        //
+        // Number of operations that have not completed yet
+        //
+        int32 NumPending{ 0 };
+
+        bool bCompleted{ false };
+
+        //
+        // Combined result, holds the first error if any operation fails
+        //
+        FOnlineServiceResult Result;
+    };
+
+    //
+    // Local users other than the primary user who have joined each lobby
+    // 
+    // Key   : Lobby's Local Name
+    // Value : Account ids of the local users
+    //
+    TMap<FName, TArray<FAccountId>> LocalUserLobbyMembers;
+
+    //
+    // Batches in progress, so that they can be completed when the lobby is cleaned up
+    // 
+    // Key   : Lobby's Local Name
+    // Value : Batch in progress
+    //
+    TMap<FName, TSharedRef<FLocalUsersLobbyBatch>> LocalUsersLobbyBatches;
+
+public:
+    /**
+     * Creates a lobby with the first initialized local user and joins it with all other initialized local users
+     * 
+     * Tips:
+     *	Completes once all local users have joined. If any of them fails, the lobby is left by all local users and the create fails.
+     *	Each local user's join has the join timeout, and CancelLobbyOperation with the request cancels all of them.
+     */
+    virtual bool CreateLobbyForLocalUsers(
+        ULobbyCreateRequest* CreateRequest
+        , FLobbyCreateCompleteDelegate Delegate = FLobbyCreateCompleteDelegate());
+
+    /**
+     * Joins the lobby with all initialized local users at the same time
+     * 
+     * Tips:
+     *	Completes once all local users have joined. If any of them fails, the lobby is left by all local users and the join fails.
+     *	Each local user's join has the join timeout, and CancelLobbyOperation with the request cancels all of them.
+     */
+    virtual bool JoinLobbyForLocalUsers(
+        ULobbyJoinRequest* JoinRequest
+        , FLobbyJoinCompleteDelegate Delegate = FLobbyJoinCompleteDelegate());
+
+protected:
+    /**
+     * Returns the local player of the first initialized local user, and the account ids of the other initialized local users on the context
+     */
+    ULocalPlayer* GetLocalUsersForLobby(EOnlineServiceContext Context, TArray<FAccountId>& OutMemberAccountIds) const;
+
+    /**
+     * Joins the lobby of the request with the primary player and the member accounts at the same time, returns false if the batch was not started
+     */
+    bool JoinLobbyForLocalUsersInternal(
+        ULocalPlayer* PrimaryPlayer
+        , TArray<FAccountId> MemberAccountIds
+        , ULobbyJoinRequest* JoinRequest
+        , FLobbyJoinCompleteDelegate Delegate);
+
+    void HandleLocalUsersCreateComplete(ULobbyCreateRequest* CreateRequest, FOnlineServiceResult Result, TSharedRef<FLocalUsersLobbyBatch> Batch);
+    void HandleLocalUsersPrimaryJoinComplete(ULobbyJoinRequest* JoinRequest, FOnlineServiceResult Result, TSharedRef<FLocalUsersLobbyBatch> Batch);
+
+    /**
+     * Joins the lobby of the batch with all member accounts at the same time, each join is tracked as a join operation
+     */
+    void StartLocalUsersMemberJoin(TSharedRef<FLocalUsersLobbyBatch> Batch);
+
+    void HandleLocalUsersMemberJoinComplete(const TOnlineResult<FJoinLobby>& JoinResult, FLobbyOperationKey OperationKey, TSharedRef<FLocalUsersLobbyBatch> Batch, FAccountId MemberAccountId);
+
+    /**
+     * Notifies the combined result once all operations have completed, leaving the lobby with all local users if any failed
+     */
+    void TryCompleteLocalUsersBatch(TSharedRef<FLocalUsersLobbyBatch> Batch);
+
+    /**
+     * Completes the batch in progress for the lobby with a cancelled result without waiting for its operations
+     */
+    void CancelLocalUsersLobbyBatch(FName LocalName);
+
+    /**
+     * Leaves the lobby with the local user accounts without waiting for the result
+     */
+    void LeaveLobbyForLocalUsers(const FLobbyId& LobbyId, EOnlineServiceContext Context, const TArray<FAccountId>& AccountIds);
+
+
+    //////////////////////////////////////////////////////////////////////
+    // Lobby History
+protected:
+    //
+    // What has been observed about lobbies found in searches, used to rank them
+    // 
+    // Key   : Lobby Id
+    // Value : Observed history
+    //
+    TMap<FLobbyId, FLobbyHistoryEntry> LobbyHistory;
+
+public:
+    /**
+     * Records that joining the lobby has failed, called automatically when a join fails
+     */
+    virtual void ReportLobbyJoinFailure(const FLobbyId& LobbyId, ELobbyJoinFailureReason Reason = ELobbyJoinFailureReason::Unknown);
+
+    /**
+     * Records the latency measured to the lobby, used to prefer closer lobbies when ranking
+     */
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual void ReportLobbyLatency(const ULobbyResult* LobbyResult, float LatencyMs);
+
+    const TMap<FLobbyId, FLobbyHistoryEntry>& GetLobbyHistory() const { return LobbyHistory; }
+
+protected:
+    FLobbyHistoryEntry& FindOrAddLobbyHistory(const FLobbyId& LobbyId);
+
+    /**
+     * Removes history entries that have not been updated within the retention time
+     */
+    void TrimLobbyHistory();
+
+
+    //////////////////////////////////////////////////////////////////////
+    // Lobby Blacklist
+protected:
+    //
+    // Lobbies excluded from search results and QuickPlay candidates after a failed join
+    // 
+    // Key   : Lobby Id
+    // Value : Failure reason and expiry
+    // 
+    // Tips:
+    //	Expired entries are kept for as long again to detect lobbies that fail again right after expiring.
+    //
+    TMap<FLobbyId, FLobbyBlacklistEntry> LobbyBlacklist;
+
+    //
+    // Counters of the blacklist for each failure reason
+    //
+    FLobbyBlacklistStats LobbyBlacklistStats[static_cast<uint8>(ELobbyJoinFailureReason::MAX)];
+
+public:
+    /**
+     * Excludes the lobby from searches for the duration set for the reason in the developer settings
+     */
+    virtual void BlacklistLobby(const FLobbyId& LobbyId, ELobbyJoinFailureReason Reason);
+
+    /**
+     * Returns true if the lobby is currently excluded, counts a hit for the reason if bCountHit is true
+     */
+    bool IsLobbyBlacklisted(const FLobbyId& LobbyId, bool bCountHit = false);
+
+    /**
+     * Returns the counters of the blacklist for the reason, used to tune the durations
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lobby")
+    FLobbyBlacklistStats GetLobbyBlacklistStats(ELobbyJoinFailureReason Reason) const;
+
+    /**
+     * Removes all lobbies from the blacklist, the counters are kept
+     */
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual void ClearLobbyBlacklist();
+
+protected:
+    /**
+     * Returns the reason of the failed join from the error and the last known state of the lobby
+     */
+    static ELobbyJoinFailureReason ClassifyLobbyJoinFailure(const FOnlineError& Error, const ULobbyResult* LobbyResult);
+
+    /**
+     * Removes entries that expired longer ago than their duration
+     */
+    void TrimLobbyBlacklist();
 
 
     //////////////////////////////////////////////////////////////////////
@@ -274,14 +825,21 @@ protected:
         FName LocalName
         , const FAccountId& LocalAccountId
         , const FLobbyId& LobbyId
+        , EOnlineServiceContext Context
         , FLobbyLeaveCompleteDelegate Delegate = FLobbyLeaveCompleteDelegate());
 
     virtual void HandleLeaveLobbyComplete(
         const TOnlineResult<FLeaveLobby>& LeaveResult
-        , FName LocalName
+        , FLobbyOperationKey OperationKey
         , FLobbyLeaveCompleteDelegate Delegate);
 
-    virtual void CleanUpOngoingRequest();
+    /**
+     * Discards the create, search and join operations in progress for the lobby with the local name
+     * 
+     * Tips:
+     *	Modifications and leaves are left to complete or time out on their own, so that their callers are always notified.
+     */
+    virtual void CleanUpOngoingRequest(FName LocalName);
 
 
     //////////////////////////////////////////////////////////////////////
@@ -298,6 +856,164 @@ protected:
         , FOnlineServiceResult Result);
 
 
+    //////////////////////////////////////////////////////////////////////
+    // Staged Lobby Invite
+protected:
+    //
+    // Join started speculatively when an invite was received, waiting for the game to accept or reject it
+    //
+    UPROPERTY(Transient)
+    TObjectPtr<ULobbyJoinRequest> StagedInviteJoinRequest{ nullptr };
+
+    //
+    // Result of the speculative join, only valid once it has completed
+    //
+    FOnlineServiceResult StagedInviteResult;
+
+    bool bStagedInviteJoinCompleted{ false };
+
+    //
+    // Account of the local user who received the invite, the lobby is left with this account if the invite is rejected
+    //
+    FAccountId StagedInviteAccountId;
+
+    //
+    // Player who accepted the invite before the join completed, the travel starts as soon as it completes
+    //
+    TWeakObjectPtr<APlayerController> StagedInviteConfirmingPlayer;
+
+    //
+    // Speculative joins rejected before they completed, the lobby is left as soon as each of them completes
+    //
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<ULobbyJoinRequest>> RejectedInviteJoinRequests;
+
+    FTimerHandle StagedInviteTimeoutHandle;
+
+public:
+    /**
+     * Returns true if an invite has been received and joined speculatively, and is waiting to be accepted or rejected
+     */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lobby")
+    virtual bool HasStagedLobbyInvite() const;
+
+    /**
+     * Accepts the staged invite and travels to the lobby, waiting for the join to complete if still in progress
+     * 
+     * Tips:
+     *	Returns false if there is no staged invite or the speculative join has failed, join the lobby normally in that case.
+     */
+	UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual bool ConfirmStagedLobbyInvite(APlayerController* InPlayerController);
+
+    /**
+     * Rejects the staged invite and leaves the lobby joined speculatively
+     */
+	UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual void RejectStagedLobbyInvite();
+
+protected:
+    /**
+     * Starts joining the requested lobby if enabled in the developer settings, returns false if the join was not started
+     */
+    bool StartSpeculativeInviteJoin(const FPlatformUserId& LocalPlatformUserId, ULobbyResult* RequestedLobby);
+
+    void HandleSpeculativeInviteJoinComplete(ULobbyJoinRequest* JoinRequest, FOnlineServiceResult Result, FAccountId InvitedAccountId);
+
+    /**
+     * Leaves the lobby joined speculatively with the account of the invited user only, other operations of the lobby are left untouched
+     */
+    void LeaveRejectedInviteLobby(ULobbyJoinRequest* JoinRequest, const FAccountId& InvitedAccountId);
+
+    void HandleStagedInviteTimeout();
+
+    void ResetStagedInvite();
+
+
+    //////////////////////////////////////////////////////////////////////
+    // Lobby Handoff
+public:
+    UPROPERTY(BlueprintAssignable, Category = "Lobby", meta = (DisplayName = "On Lobby Handoff Received"))
+    FLobbyHandoffReceivedDynamicDelegate K2_OnLobbyHandoffReceived;
+    FLobbyHandoffReceivedDelegate OnLobbyHandoffReceived;
+
+public:
+    /**
+     * Hands the party off to the game lobby by publishing it in a single attribute write on the party lobby
+     * 
+     * Tips:
+     *	Only the leader of the party lobby can hand it off, and the game lobby must have been joined in the same service context.
+     *	The write is sent immediately even if attribute modifications are debounced.
+     *	Party members start joining the game lobby as soon as they receive the attribute change.
+     */
+    virtual bool HandoffLobby(
+        APlayerController* InPlayerController
+        , const ULobbyResult* PartyLobby
+        , const ULobbyResult* GameLobby
+        , FLobbyModifyCompleteDelegate Delegate = FLobbyModifyCompleteDelegate());
+
+protected:
+    /**
+     * Encodes the game lobby into the value of the handoff attribute
+     */
+    FString EncodeLobbyHandoff(const ULobbyResult* GameLobby) const;
+
+    /**
+     * Decodes the value of the handoff attribute into a lobby result describing the game lobby, returns null if the value is invalid
+     */
+    ULobbyResult* DecodeLobbyHandoff(const FString& Value, EOnlineServiceContext Context);
+
+    /**
+     * Starts joining the game lobby handed off by the leader of the party lobby
+     */
+    void HandleLobbyHandoff(const FLobby& PartyLobby);
+
+    void NotifyLobbyHandoffReceived(FName PartyLocalName, ULobbyJoinRequest* JoinRequest);
+
+
+    //////////////////////////////////////////////////////////////////////
+    // Lobby Event Dispatch
+protected:
+    //
+    // Lobby events waiting to be notified at the next frame
+    //
+    struct FPendingLobbyEvents
+    {
+        //
+        // Latest member count of each lobby
+        // 
+        // Key   : Lobby's Local Name
+        // Value : Current members and max members
+        //
+        TMap<FName, TPair<int32, int32>> MemberChanged;
+
+        TArray<FName> LeaderChanged;
+        TArray<FName> BecomeLeader;
+
+        TMap<FName, FLobbyAttributeChanges> AttributesChanged;
+        TMap<TPair<FName, FAccountId>, FLobbyAttributeChanges> MemberAttributesChanged;
+
+        bool IsEmpty() const { return MemberChanged.IsEmpty() && LeaderChanged.IsEmpty() && BecomeLeader.IsEmpty() && AttributesChanged.IsEmpty() && MemberAttributesChanged.IsEmpty(); }
+    };
+
+    FPendingLobbyEvents PendingLobbyEvents;
+
+    FTimerHandle LobbyEventFlushTimerHandle;
+
+protected:
+    /**
+     * Returns true if lobby events should be queued instead of notified immediately
+     */
+    bool ShouldQueueLobbyEvents() const;
+
+    /**
+     * Schedules the notification of all queued events at the next frame, does nothing if already scheduled
+     */
+    void ScheduleLobbyEventFlush();
+
+    void FlushLobbyEvents();
+
+
     //////////////////////////////////////////////////////////////////////
     // Lobby Member Change
 public:
@@ -307,6 +1023,77 @@ public:
 
 protected:
     void NotifyLobbyMemberChanged(FName LocalName, int32 CurrentMembers, int32 MaxMembers);
+    void BroadcastLobbyMemberChanged(FName LocalName, int32 CurrentMembers, int32 MaxMembers);
+
+
+    //////////////////////////////////////////////////////////////////////
+    // Lobby Roster
+protected:
+    //
+    // Member index of each joined lobby
+    // 
+    // Key   : Lobby's Local Name
+    // Value : Members of the lobby by account id
+    //
+    TMap<FName, FLobbyRoster> LobbyRosters;
+
+    //
+    // Roster changes waiting to be notified at the next frame
+    //
+    TMap<FName, FLobbyRosterDelta> PendingRosterDeltas;
+
+public:
+    //
+    // Notified at most once per frame for each lobby with the members added, removed and changed during the frame
+    //
+    UPROPERTY(BlueprintAssignable, Category = "Lobby", meta = (DisplayName = "On Lobby Roster Changed"))
+    FLobbyRosterChangedDynamicDelegate K2_OnLobbyRosterChanged;
+    FLobbyRosterChangedDelegate OnLobbyRosterChanged;
+
+    /**
+     * Returns the member index of the joined lobby, will return null if not joined
+     */
+    const FLobbyRoster* GetLobbyRoster(FName LocalName) const { return LobbyRosters.Find(LocalName); }
+
+protected:
+    /**
+     * Returns the roster of the lobby, building it from the lobby if it does not exist yet
+     * 
+     * Tips:
+     *	When built, all members of the lobby are notified as added.
+     */
+    FLobbyRoster& FindOrAddLobbyRoster(const FLobby& InLobby);
+
+    FLobbyRosterDelta& GetPendingRosterDelta(FName LocalName);
+
+    void NotifyLobbyRosterChanged();
+
+
+    //////////////////////////////////////////////////////////////////////
+    // Lobby Attribute Change
+protected:
+    //
+    // Copy of the attributes of each joined lobby at the last notification
+    // 
+    // Key   : Lobby's Local Name
+    // Value : Attributes on online service
+    //
+    TMap<FName, TMap<FSchemaAttributeId, FSchemaVariant>> LobbyAttributeSnapshots;
+
+public:
+    UPROPERTY(BlueprintAssignable, Category = "Lobby", meta = (DisplayName = "On Lobby Attributes Changed"))
+    FLobbyAttributesChangedDynamicDelegate K2_OnLobbyAttributesChanged;
+    FLobbyAttributesChangedDelegate OnLobbyAttributesChanged;
+
+    UPROPERTY(BlueprintAssignable, Category = "Lobby", meta = (DisplayName = "On Lobby Member Attributes Changed"))
+    FLobbyAttributesChangedDynamicDelegate K2_OnLobbyMemberAttributesChanged;
+    FLobbyAttributesChangedDelegate OnLobbyMemberAttributesChanged;
+
+protected:
+    void NotifyLobbyAttributesChanged(const FLobbyAttributeChanges& Changes);
+    void NotifyLobbyMemberAttributesChanged(const FLobbyAttributeChanges& Changes);
+    void BroadcastLobbyAttributesChanged(const FLobbyAttributeChanges& Changes);
+    void BroadcastLobbyMemberAttributesChanged(const FLobbyAttributeChanges& Changes);
 
 
     //////////////////////////////////////////////////////////////////////
@@ -323,6 +1110,8 @@ public:
 protected:
     void NotifyLobbyLeaderChanged(FName LocalName);
     void NotifyLobbyBecomeLeader(FName LocalName);
+    void BroadcastLobbyLeaderChanged(FName LocalName);
+    void BroadcastLobbyBecomeLeader(FName LocalName);
 
 
     //////////////////////////////////////////////////////////////////////
@@ -332,6 +1121,61 @@ public:
     virtual bool TravelToLobby(APlayerController* InPlayerController, const ULobbyResult* LobbyResult);
 
 
+    //////////////////////////////////////////////////////////////////////
+    // Lobby Map Preload
+protected:
+    //
+    // Map being loaded while a lobby is created or joined
+    //
+    struct FLobbyMapPreload
+    {
+        //
+        // Package name of the map
+        //
+        FString MapName;
+
+        //
+        // Handle that keeps the map loaded until released
+        //
+        TSharedPtr<FStreamableHandle> Handle;
+    };
+
+    //
+    // Maps being loaded or loaded for each lobby
+    // 
+    // Key   : Lobby's Local Name
+    // Value : Map preload
+    //
+    TMap<FName, FLobbyMapPreload> LobbyMapPreloads;
+
+    //
+    // Map preload handed over to the travel in progress, released once the new map has been loaded
+    //
+    TSharedPtr<FStreamableHandle> TravelMapPreloadHandle;
+
+    FDelegateHandle PostLoadMapDelegateHandle;
+
+public:
+    /**
+     * Returns true if the map of the lobby has been preloaded and is ready for travel
+     */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lobby")
+    virtual bool IsLobbyMapPreloaded(FName LocalName) const;
+
+protected:
+    /**
+     * Starts loading the map for the lobby if enabled in the developer settings or bForce is true, does nothing if the same map is already loading
+     */
+    void StartLobbyMapPreload(FName LocalName, const FString& MapName, bool bForce = false);
+
+    /**
+     * Releases the map loaded for the lobby
+     */
+    void ReleaseLobbyMapPreload(FName LocalName);
+
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+
+
     //////////////////////////////////////////////////////////////////////
     // Modify Lobby
 
@@ -352,6 +1196,7 @@ protected:
 
     virtual void HandleModifyLobbyJoinPolicyComplete(
         const TOnlineResult<FModifyLobbyJoinPolicy>& ModifyResult
+        , FLobbyOperationKey OperationKey
         , const ULobbyResult* LobbyResult
         , FLobbyModifyCompleteDelegate Delegate);
 
@@ -374,6 +1219,130 @@ protected:
 
     virtual void HandleModifyLobbyAttributeComplete(
         const TOnlineResult<FModifyLobbyAttributes>& ModifyResult
+        , FLobbyOperationKey OperationKey
         , const ULobbyResult* LobbyResult
         , FLobbyModifyCompleteDelegate Delegate);
+
+    // ==== Attribute Queue ===
+protected:
+    //
+    // Lobby attribute modifications waiting to be sent to a lobby
+    //
+    struct FLobbyAttributeModifyQueue
+    {
+        TWeakObjectPtr<ULocalPlayer> LocalPlayer;
+        TWeakObjectPtr<const ULobbyResult> LobbyResult;
+
+        //
+        // Pending attributes by name (last write wins), a name is either in ToChange or in ToRemove
+        //
+        TMap<FName, FLobbyAttribute> ToChange;
+        TSet<FName> ToRemove;
+
+        //
+        // Delegates of all callers merged into this queue
+        //
+        TArray<FLobbyModifyCompleteDelegate> Delegates;
+
+        FTimerHandle FlushTimerHandle;
+    };
+
+    //
+    // Queued lobby attribute modifications for each lobby
+    //
+    TMap<FLobbyId, FLobbyAttributeModifyQueue> LobbyAttributeModifyQueues;
+
+    //
+    // Lobbies whose flushed modification has not completed yet
+    // 
+    // Tips:
+    //	Only one flush per lobby is sent at a time, so that queued values are compared against attributes that include the previous flush.
+    //
+    TSet<FLobbyId> LobbyAttributeFlushesInFlight;
+
+public:
+    /**
+     * Sends the queued attribute modifications of the lobby immediately
+     */
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual void FlushLobbyAttributeModifications(const ULobbyResult* LobbyResult);
+
+    /**
+     * Sends the queued attribute modifications of all lobbies immediately
+     */
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual void FlushAllLobbyAttributeModifications();
+
+protected:
+    void QueueLobbyAttributeModification(
+        ULocalPlayer* LocalPlayer
+        , const ULobbyResult* LobbyResult
+        , const TSet<FLobbyAttribute>& AttrToChange
+        , const TSet<FLobbyAttribute>& AttrToRemove
+        , FLobbyModifyCompleteDelegate Delegate);
+
+    void HandleLobbyAttributeModifyDebounceExpired(FLobbyId LobbyId);
+
+    void FlushLobbyAttributeModifyQueue(const FLobbyId& LobbyId);
+
+    // ==== Transaction ===
+public:
+    /**
+     * Creates a transaction that collects multiple lobby modifications
+     */
+    UFUNCTION(BlueprintCallable, Category = "Lobby")
+    virtual ULobbyModifyTransaction* CreateLobbyModifyTransaction();
+
+    /**
+     * Sends all modifications of the transaction at the same time and notifies one combined result
+     */
+    virtual bool CommitLobbyModifyTransaction(
+        APlayerController* InPlayerController
+        , const ULobbyResult* LobbyResult
+        , ULobbyModifyTransaction* Transaction
+        , FLobbyModifyCompleteDelegate Delegate = FLobbyModifyCompleteDelegate());
+
+protected:
+    //
+    // State shared by the backend calls of a committed transaction
+    //
+    struct FLobbyModifyTransactionState
+    {
+        TWeakObjectPtr<const ULobbyResult> LobbyResult;
+
+        //
+        // Number of backend calls that have not completed yet
+        //
+        int32 NumPending{ 0 };
+
+        //
+        // Combined result, holds the first error if any call fails
+        //
+        FOnlineServiceResult Result;
+
+        TArray<FLobbyModifyCompleteDelegate> Delegates;
+    };
+
+    void CommitLobbyModifyTransactionInternal(
+        ULocalPlayer* LocalPlayer
+        , const ULobbyResult* LobbyResult
+        , ULobbyModifyTransaction* Transaction
+        , FLobbyModifyCompleteDelegate Delegate);
+
+    /**
+     * Registers one backend call of the transaction as a modify operation so that it has a deadline and can be cancelled
+     */
+    template<typename OpType>
+    void StartLobbyModifyTransactionStep(
+        FName LocalName
+        , ULobbyModifyTransaction* Transaction
+        , TOnlineAsyncOpHandle<OpType> Handle
+        , TSharedRef<FLobbyModifyTransactionState> State);
+
+    template<typename OpType>
+    void HandleLobbyModifyTransactionStepComplete(
+        const TOnlineResult<OpType>& StepResult
+        , FLobbyOperationKey OperationKey
+        , TSharedRef<FLobbyModifyTransactionState> State);
+
 };
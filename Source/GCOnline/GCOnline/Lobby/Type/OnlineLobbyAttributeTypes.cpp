@@ -2,6 +2,8 @@
 
 #include "OnlineLobbyAttributeTypes.h"
 
+#include "OnlineDeveloperSettings.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(OnlineLobbyAttributeTypes)
 
 
@@ -10,79 +12,169 @@
 
 void FLobbyAttribute::SetAttribute(const FString& InValue)
 {
+	ResetValue();
 	Type = ELobbyAttributeValueType::String;
 	Value = InValue;
 }
 
+void FLobbyAttribute::SetAttribute(FString&& InValue)
+{
+	ResetValue();
+	Type = ELobbyAttributeValueType::String;
+	Value = MoveTemp(InValue);
+}
+
 void FLobbyAttribute::SetAttribute(const int32& InValue)
 {
+	SetAttribute(static_cast<int64>(InValue));
+}
+
+void FLobbyAttribute::SetAttribute(const int64& InValue)
+{
+	ResetValue();
 	Type = ELobbyAttributeValueType::Integer;
-	Value = FString::FromInt(InValue);
+	IntegerValue = InValue;
 }
 
 void FLobbyAttribute::SetAttribute(const double& InValue)
 {
+	ResetValue();
 	Type = ELobbyAttributeValueType::Double;
-	Value = FString::SanitizeFloat(InValue);
+	DoubleValue = InValue;
 }
 
 void FLobbyAttribute::SetAttribute(const bool& InValue)
 {
+	ResetValue();
 	Type = ELobbyAttributeValueType::Boolean;
-	Value = InValue ? TEXT("true") : TEXT("false");
+	BooleanValue = InValue;
 }
 
 void FLobbyAttribute::SetAttribute(const TArray<FString>& InValue)
 {
+	ResetValue();
 	Type = ELobbyAttributeValueType::String;
 
-	FString NewValue;
+	auto TotalLen{ 0 };
+	for (const auto& Each : InValue)
+	{
+		TotalLen += Each.Len() + 1;
+	}
+
+	Value.Reserve(TotalLen);
+
 	for (const auto& Each : InValue)
 	{
-		NewValue += Each;
-		NewValue += TEXT(";");
+		Value.Append(Each);
+		Value.AppendChar(TEXT(';'));
 	}
+}
 
-	Value = NewValue;
+void FLobbyAttribute::ResetValue()
+{
+	Value.Reset();
+	IntegerValue = 0;
+	DoubleValue = 0.0;
+	BooleanValue = false;
 }
 
 
 FString FLobbyAttribute::GetAttributeAsString() const
 {
-	return Value;
+	switch (Type)
+	{
+	case ELobbyAttributeValueType::Integer:
+		return LexToString(IntegerValue);
+	case ELobbyAttributeValueType::Double:
+		return FString::SanitizeFloat(DoubleValue);
+	case ELobbyAttributeValueType::Boolean:
+		return BooleanValue ? TEXT("true") : TEXT("false");
+	default:
+		return Value;
+	}
 }
 
 int32 FLobbyAttribute::GetAttributeAsInteger() const
 {
-	return FCString::Atoi(*Value);
+	return static_cast<int32>(GetAttributeAsInteger64());
+}
+
+int64 FLobbyAttribute::GetAttributeAsInteger64() const
+{
+	switch (Type)
+	{
+	case ELobbyAttributeValueType::Integer:
+		return IntegerValue;
+	case ELobbyAttributeValueType::Double:
+		return static_cast<int64>(DoubleValue);
+	case ELobbyAttributeValueType::Boolean:
+		return BooleanValue ? 1 : 0;
+	default:
+		return FCString::Atoi64(*Value);
+	}
 }
 
 double FLobbyAttribute::GetAttributeAsDouble() const
 {
-	return FCString::Atod(*Value);
+	switch (Type)
+	{
+	case ELobbyAttributeValueType::Integer:
+		return static_cast<double>(IntegerValue);
+	case ELobbyAttributeValueType::Double:
+		return DoubleValue;
+	case ELobbyAttributeValueType::Boolean:
+		return BooleanValue ? 1.0 : 0.0;
+	default:
+		return FCString::Atod(*Value);
+	}
 }
 
 bool FLobbyAttribute::GetAttributeAsBoolean() const
 {
-	return Value.ToBool();
+	switch (Type)
+	{
+	case ELobbyAttributeValueType::Integer:
+		return IntegerValue != 0;
+	case ELobbyAttributeValueType::Double:
+		return DoubleValue != 0.0;
+	case ELobbyAttributeValueType::Boolean:
+		return BooleanValue;
+	default:
+		return Value.ToBool();
+	}
+}
+
+uint32 FLobbyAttribute::GetValueHash() const
+{
+	switch (Type)
+	{
+	case ELobbyAttributeValueType::Integer:
+		return GetTypeHash(IntegerValue);
+	case ELobbyAttributeValueType::Double:
+		return GetTypeHash(DoubleValue);
+	case ELobbyAttributeValueType::Boolean:
+		return GetTypeHash(BooleanValue);
+	default:
+		return GetTypeHash(Value);
+	}
 }
 
 
-FSchemaVariant FLobbyAttribute::ToSchemaVariant() const
+FSchemaVariant FLobbyAttribute::ToSchemaVariant() const &
 {
 	switch (Type)
 	{
 	case ELobbyAttributeValueType::String:
-		return FSchemaVariant(GetAttributeAsString());
+		return FSchemaVariant(Value);
 		break;
 	case ELobbyAttributeValueType::Integer:
-		return FSchemaVariant(static_cast<int64>(GetAttributeAsInteger()));
+		return FSchemaVariant(IntegerValue);
 		break;
 	case ELobbyAttributeValueType::Double:
-		return FSchemaVariant(GetAttributeAsDouble());
+		return FSchemaVariant(DoubleValue);
 		break;
 	case ELobbyAttributeValueType::Boolean:
-		return FSchemaVariant(GetAttributeAsBoolean());
+		return FSchemaVariant(BooleanValue);
 		break;
 
 	default:
@@ -91,6 +183,115 @@ FSchemaVariant FLobbyAttribute::ToSchemaVariant() const
 	}
 }
 
+FSchemaVariant FLobbyAttribute::ToSchemaVariant() &&
+{
+	if (Type == ELobbyAttributeValueType::String)
+	{
+		return FSchemaVariant(MoveTemp(Value));
+	}
+
+	return static_cast<const FLobbyAttribute&>(*this).ToSchemaVariant();
+}
+
+
+void FLobbyAttribute::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading() && (Type != ELobbyAttributeValueType::String) && !Value.IsEmpty())
+	{
+		const auto LegacyValue{ MoveTemp(Value) };
+
+		switch (Type)
+		{
+		case ELobbyAttributeValueType::Integer:
+			SetAttribute(FCString::Atoi64(*LegacyValue));
+			break;
+		case ELobbyAttributeValueType::Double:
+			SetAttribute(FCString::Atod(*LegacyValue));
+			break;
+		case ELobbyAttributeValueType::Boolean:
+			SetAttribute(LegacyValue.ToBool());
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+
+bool FLobbyAttribute::operator==(const FLobbyAttribute& Other) const
+{
+	if ((Name != Other.Name) || (Type != Other.Type))
+	{
+		return false;
+	}
+
+	switch (Type)
+	{
+	case ELobbyAttributeValueType::Integer:
+		return IntegerValue == Other.IntegerValue;
+	case ELobbyAttributeValueType::Double:
+		return DoubleValue == Other.DoubleValue;
+	case ELobbyAttributeValueType::Boolean:
+		return BooleanValue == Other.BooleanValue;
+	default:
+		return Value == Other.Value;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+// FLobbyAttributeHandle
+
+FLobbyAttributeHandle FLobbyAttributeHandle::Resolve(const FName& InName)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	FLobbyAttributeHandle NewHandle;
+	NewHandle.ProjectName = InName;
+	NewHandle.ServiceName = DevSettings->RedirectLobbyAttribute_ToOnlineService(InName);
+	NewHandle.Generation = DevSettings->GetAttributeRedirectGeneration();
+
+	return NewHandle;
+}
+
+FLobbyAttributeHandle FLobbyAttributeHandle::ResolveUser(const FName& InName)
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	FLobbyAttributeHandle NewHandle;
+	NewHandle.ProjectName = InName;
+	NewHandle.ServiceName = DevSettings->RedirectUserLobbyAttribute_ToOnlineService(InName);
+	NewHandle.Generation = DevSettings->GetAttributeRedirectGeneration();
+
+	return NewHandle;
+}
+
+bool FLobbyAttributeHandle::IsUpToDate() const
+{
+	return Generation == GetDefault<UOnlineDeveloperSettings>()->GetAttributeRedirectGeneration();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+// FLobbyAttributeSchemaEntry
+
+bool FLobbyAttributeSchemaEntry::MatchesValueType(const FSchemaVariant& InValue) const
+{
+	switch (Type)
+	{
+	case ELobbyAttributeValueType::String:
+		return InValue.GetType() == ESchemaAttributeType::String;
+	case ELobbyAttributeValueType::Integer:
+		return InValue.GetType() == ESchemaAttributeType::Int64;
+	case ELobbyAttributeValueType::Double:
+		return InValue.GetType() == ESchemaAttributeType::Double;
+	case ELobbyAttributeValueType::Boolean:
+		return InValue.GetType() == ESchemaAttributeType::Bool;
+	default:
+		return false;
+	}
+}
+
 
 //////////////////////////////////////////////////////////////////////////////
 // FLobbyAttributeFilter
@@ -99,3 +300,70 @@ FFindLobbySearchFilter FLobbyAttributeFilter::ToSearchFilter() const
 {
 	return FFindLobbySearchFilter(Attribute.GetAttributeName(), static_cast<ESchemaAttributeComparisonOp>(ComparisonOp), Attribute.ToSchemaVariant());
 }
+
+
+//////////////////////////////////////////////////////////////////////////////
+// FLobbyAttributeChanges
+
+void FLobbyAttributeChanges::Diff(const TMap<FSchemaAttributeId, FSchemaVariant>& Previous, const TMap<FSchemaAttributeId, FSchemaVariant>& Current, TFunctionRef<FName(const FName&)> ToProject)
+{
+	for (const auto& KVP : Current)
+	{
+		if (const auto* PreviousValue{ Previous.Find(KVP.Key) })
+		{
+			if (!(*PreviousValue == KVP.Value))
+			{
+				ChangedAttributes.Emplace(ToProject(KVP.Key));
+			}
+		}
+		else
+		{
+			AddedAttributes.Emplace(ToProject(KVP.Key));
+		}
+	}
+
+	for (const auto& KVP : Previous)
+	{
+		if (!Current.Contains(KVP.Key))
+		{
+			RemovedAttributes.Emplace(ToProject(KVP.Key));
+		}
+	}
+}
+
+void FLobbyAttributeChanges::Append(const FLobbyAttributeChanges& Later)
+{
+	for (const auto& Name : Later.AddedAttributes)
+	{
+		// Removed and added again
+
+		if (RemovedAttributes.Remove(Name) > 0)
+		{
+			ChangedAttributes.AddUnique(Name);
+		}
+		else
+		{
+			AddedAttributes.AddUnique(Name);
+		}
+	}
+
+	for (const auto& Name : Later.ChangedAttributes)
+	{
+		if (!AddedAttributes.Contains(Name))
+		{
+			ChangedAttributes.AddUnique(Name);
+		}
+	}
+
+	for (const auto& Name : Later.RemovedAttributes)
+	{
+		ChangedAttributes.Remove(Name);
+
+		// Added and removed again
+
+		if (AddedAttributes.Remove(Name) == 0)
+		{
+			RemovedAttributes.AddUnique(Name);
+		}
+	}
+}
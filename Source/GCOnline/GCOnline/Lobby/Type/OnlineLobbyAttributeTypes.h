@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "GameFramework/OnlineReplStructs.h"
 
 #include "Online/Lobbies.h"
 
@@ -53,6 +54,11 @@ enum class ELobbyAttributeValueType : uint8
 
 /**
  * Data for modifying lobby attributes
+ * 
+ * Tips:
+ *	The value is stored natively in the slot matching Type, so converting to FSchemaVariant does not parse any text.
+ *	The string accessors format the value only when the value type is not String.
+ *	Blueprint sets and reads the value only through ULobbyAttributeLibrary, so the value and its type cannot get out of sync.
  */
 USTRUCT(BlueprintType)
 struct GCONLINE_API FLobbyAttribute
@@ -62,19 +68,47 @@ public:
 	FLobbyAttribute() = default;
 	FLobbyAttribute(const FName& InName) : Name(InName) {}
 	FLobbyAttribute(const FName& InName, const FString& InValue) : Name(InName) { SetAttribute(InValue); }
+	FLobbyAttribute(const FName& InName, FString&& InValue) : Name(InName) { SetAttribute(MoveTemp(InValue)); }
 	FLobbyAttribute(const FName& InName, const int32& InValue) : Name(InName) { SetAttribute(InValue); }
+	FLobbyAttribute(const FName& InName, const int64& InValue) : Name(InName) { SetAttribute(InValue); }
 	FLobbyAttribute(const FName& InName, const double& InValue) : Name(InName) { SetAttribute(InValue); }
 	FLobbyAttribute(const FName& InName, const bool& InValue) : Name(InName) { SetAttribute(InValue); }
 	FLobbyAttribute(const FName& InName, const TArray<FString>& InValue) : Name(InName) { SetAttribute(InValue); }
 
+	FLobbyAttribute(const FLobbyAttribute&) = default;
+	FLobbyAttribute(FLobbyAttribute&&) = default;
+	FLobbyAttribute& operator=(const FLobbyAttribute&) = default;
+	FLobbyAttribute& operator=(FLobbyAttribute&&) = default;
+
 protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FName Name;
 
-	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	//
+	// Value when Type is String
+	//
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "Type == ELobbyAttributeValueType::String", EditConditionHides))
 	FString Value;
 
-	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	//
+	// Value when Type is Integer
+	//
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "Type == ELobbyAttributeValueType::Integer", EditConditionHides))
+	int64 IntegerValue{ 0 };
+
+	//
+	// Value when Type is Double
+	//
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "Type == ELobbyAttributeValueType::Double", EditConditionHides))
+	double DoubleValue{ 0.0 };
+
+	//
+	// Value when Type is Boolean
+	//
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "Type == ELobbyAttributeValueType::Boolean", EditConditionHides))
+	bool BooleanValue{ false };
+
+	UPROPERTY(EditAnywhere)
 	ELobbyAttributeValueType Type{ ELobbyAttributeValueType::String };
 
 public:
@@ -84,25 +118,143 @@ public:
 	const ELobbyAttributeValueType& GetValueType() const { return Type; }
 
 	void SetAttribute(const FString& InValue);
+	void SetAttribute(FString&& InValue);
 	void SetAttribute(const int32& InValue);
+	void SetAttribute(const int64& InValue);
 	void SetAttribute(const double& InValue);
 	void SetAttribute(const bool& InValue);
 	void SetAttribute(const TArray<FString>& InValue);
 
 	FString GetAttributeAsString() const;
 	int32 GetAttributeAsInteger() const;
+	int64 GetAttributeAsInteger64() const;
 	double GetAttributeAsDouble() const;
 	bool GetAttributeAsBoolean() const;
 
-	FSchemaVariant ToSchemaVariant() const;
+	/**
+	 * Returns the hash of the stored value without formatting it to text
+	 */
+	uint32 GetValueHash() const;
+
+	FSchemaVariant ToSchemaVariant() const &;
+	FSchemaVariant ToSchemaVariant() &&;
+
+	/**
+	 * Moves values saved by older versions, which stored every type as text, into the typed slot
+	 */
+	void PostSerialize(const FArchive& Ar);
+
+protected:
+	void ResetValue();
 
 public:
-	bool operator==(const FLobbyAttribute& Other) const { return (Name == Other.Name) && (Value == Other.Value) && (Type == Other.Type); }
+	bool operator==(const FLobbyAttribute& Other) const;
 
 	friend FORCEINLINE uint32 GetTypeHash(const FLobbyAttribute& Attr) { return GetTypeHash(Attr.Name); }
 
 };
 
+template<>
+struct TStructOpsTypeTraits<FLobbyAttribute> : public TStructOpsTypeTraitsBase2<FLobbyAttribute>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
+
+/**
+ * Lobby attribute name resolved to the name on the online service
+ * 
+ * Tips:
+ *	Resolve once and reuse it on hot paths instead of looking up the redirect on every attribute access.
+ *	The handle keeps the resolved name even if the redirect settings are changed, use IsUpToDate() to detect it.
+ */
+USTRUCT()
+struct GCONLINE_API FLobbyAttributeHandle
+{
+	GENERATED_BODY()
+public:
+	FLobbyAttributeHandle() = default;
+
+	static FLobbyAttributeHandle Resolve(const FName& InName);
+	static FLobbyAttributeHandle ResolveUser(const FName& InName);
+
+protected:
+	//
+	// Name used in the project
+	//
+	UPROPERTY()
+	FName ProjectName{ NAME_None };
+
+	//
+	// Name on online service
+	//
+	UPROPERTY()
+	FName ServiceName{ NAME_None };
+
+	//
+	// Generation of the redirect tables that this handle was resolved with
+	//
+	uint32 Generation{ 0 };
+
+public:
+	bool IsValid() const { return !ProjectName.IsNone(); }
+	bool IsUpToDate() const;
+
+	const FName& GetProjectName() const { return ProjectName; }
+	const FName& GetServiceName() const { return ServiceName; }
+
+};
+
+
+/**
+ * Entry of the lobby attribute schema declared in the developer settings
+ */
+USTRUCT(BlueprintType)
+struct GCONLINE_API FLobbyAttributeSchemaEntry
+{
+	GENERATED_BODY()
+public:
+	FLobbyAttributeSchemaEntry() = default;
+
+public:
+	//
+	// Name to be used for the project
+	//
+	UPROPERTY(BlueprintReadOnly, EditAnywhere)
+	FName Name{ NAME_None };
+
+	//
+	// Type of value stored in this attribute
+	//
+	UPROPERTY(BlueprintReadOnly, EditAnywhere)
+	ELobbyAttributeValueType Type{ ELobbyAttributeValueType::String };
+
+	//
+	// Name on online service
+	// 
+	// Tips:
+	//	If not set, the redirect of the lobby attribute is used.
+	//
+	UPROPERTY(BlueprintReadOnly, EditAnywhere)
+	FName ServiceName{ NAME_None };
+
+	//
+	// Whether this attribute can be used for lobby search filters
+	//
+	UPROPERTY(BlueprintReadOnly, EditAnywhere)
+	bool bSearchable{ true };
+
+public:
+	/**
+	 * Returns true if the type of the value on online service matches this entry
+	 */
+	bool MatchesValueType(const FSchemaVariant& InValue) const;
+
+};
+
+
 UCLASS(MinimalAPI)
 class ULobbyAttributeLibrary : public UObject
 {
@@ -121,6 +273,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lobby Attribute")
 	static GCONLINE_API void SetAttributeFromBoolean(UPARAM(ref) FLobbyAttribute& Attribute, bool InValue) { Attribute.SetAttribute(InValue); }
 
+	UFUNCTION(BlueprintPure, Category = "Lobby Attribute")
+	static GCONLINE_API ELobbyAttributeValueType GetAttributeValueType(const FLobbyAttribute& Attribute) { return Attribute.GetValueType(); }
+
+	UFUNCTION(BlueprintPure, Category = "Lobby Attribute")
+	static GCONLINE_API FString GetAttributeAsString(const FLobbyAttribute& Attribute) { return Attribute.GetAttributeAsString(); }
+
+	UFUNCTION(BlueprintPure, Category = "Lobby Attribute")
+	static GCONLINE_API int32 GetAttributeAsInteger(const FLobbyAttribute& Attribute) { return Attribute.GetAttributeAsInteger(); }
+
+	UFUNCTION(BlueprintPure, Category = "Lobby Attribute")
+	static GCONLINE_API double GetAttributeAsDouble(const FLobbyAttribute& Attribute) { return Attribute.GetAttributeAsDouble(); }
+
+	UFUNCTION(BlueprintPure, Category = "Lobby Attribute")
+	static GCONLINE_API bool GetAttributeAsBoolean(const FLobbyAttribute& Attribute) { return Attribute.GetAttributeAsBoolean(); }
+
 };
 
 
@@ -152,3 +319,58 @@ public:
 	FFindLobbySearchFilter ToSearchFilter() const;
 
 };
+
+
+/**
+ * Attribute names that changed on a lobby or a lobby member
+ * 
+ * Tips:
+ *	Names are redirected to the names used in the project.
+ */
+USTRUCT(BlueprintType)
+struct GCONLINE_API FLobbyAttributeChanges
+{
+	GENERATED_BODY()
+public:
+	FLobbyAttributeChanges() = default;
+	FLobbyAttributeChanges(const FName& InLocalName) : LocalName(InLocalName) {}
+
+public:
+	//
+	// Local name of the lobby
+	//
+	UPROPERTY(BlueprintReadOnly)
+	FName LocalName{ NAME_None };
+
+	//
+	// Member whose attributes changed, invalid for lobby attributes
+	//
+	UPROPERTY(BlueprintReadOnly)
+	FUniqueNetIdRepl MemberId;
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FName> AddedAttributes;
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FName> ChangedAttributes;
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FName> RemovedAttributes;
+
+public:
+	bool IsEmpty() const { return AddedAttributes.IsEmpty() && ChangedAttributes.IsEmpty() && RemovedAttributes.IsEmpty(); }
+
+	/**
+	 * Lists the attributes that differ between the snapshots, with names redirected by ToProject
+	 */
+	void Diff(
+		const TMap<FSchemaAttributeId, FSchemaVariant>& Previous
+		, const TMap<FSchemaAttributeId, FSchemaVariant>& Current
+		, TFunctionRef<FName(const FName&)> ToProject);
+
+	/**
+	 * Merges later changes into these changes
+	 */
+	void Append(const FLobbyAttributeChanges& Later);
+
+};
@@ -0,0 +1,105 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Online/Lobbies.h"
+
+#include "OnlineLobbyBlacklistTypes.generated.h"
+
+using namespace UE::Online;
+
+
+/////////////////////////////////////////////////////
+// Enums
+
+/**
+ * Reason why joining a lobby has failed, used to decide how long the lobby is excluded from searches
+ */
+UENUM(BlueprintType)
+enum class ELobbyJoinFailureReason : uint8
+{
+	//
+	// Failed for a reason that could not be identified
+	//
+	Unknown,
+
+	//
+	// Lobby had no open slot
+	//
+	Full,
+
+	//
+	// Lobby no longer exists
+	//
+	NotFound,
+
+	//
+	// Lobby does not allow the user to join
+	//
+	JoinPolicy,
+
+	MAX UMETA(Hidden)
+};
+
+
+/////////////////////////////////////////////////////
+// Structs
+
+/**
+ * Lobby excluded from searches after a failed join
+ */
+struct GCONLINE_API FLobbyBlacklistEntry
+{
+public:
+	FLobbyBlacklistEntry() = default;
+
+public:
+	//
+	// Reason of the failed join that added this entry
+	//
+	ELobbyJoinFailureReason Reason{ ELobbyJoinFailureReason::Unknown };
+
+	//
+	// Time in seconds after which the lobby is no longer excluded
+	//
+	double ExpireTime{ 0.0 };
+
+public:
+	bool IsExpired(double CurrentTime) const { return CurrentTime >= ExpireTime; }
+
+};
+
+
+/**
+ * Counters of the lobby blacklist for a failure reason, used to tune how long lobbies are excluded
+ */
+USTRUCT(BlueprintType)
+struct GCONLINE_API FLobbyBlacklistStats
+{
+	GENERATED_BODY()
+public:
+	FLobbyBlacklistStats() = default;
+
+public:
+	//
+	// Number of times a lobby has been added to the blacklist
+	//
+	UPROPERTY(BlueprintReadOnly)
+	int32 NumAdded{ 0 };
+
+	//
+	// Number of times a blacklisted lobby has been excluded from search results or quick play candidates
+	//
+	UPROPERTY(BlueprintReadOnly)
+	int32 NumHits{ 0 };
+
+	//
+	// Number of times a lobby failed again for the same reason shortly after its entry expired
+	// 
+	// Tips:
+	//	A high value compared to NumAdded suggests that the duration is too short.
+	//
+	UPROPERTY(BlueprintReadOnly)
+	int32 NumRepeatedAfterExpiry{ 0 };
+
+};
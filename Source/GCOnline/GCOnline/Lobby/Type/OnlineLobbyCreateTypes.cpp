@@ -6,10 +6,93 @@
 
 #include "Online/OnlineSessionNames.h"
 #include "Engine/AssetManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(OnlineLobbyCreateTypes)
 
 
+/////////////////////////////////////////////////////////////////
+// FLobbyMapNameCache
+
+TMap<FPrimaryAssetId, FString> FLobbyMapNameCache::ResolvedMapNames;
+TArray<FDelegateHandle> FLobbyMapNameCache::AssetRegistryDelegateHandles;
+uint32 FLobbyMapNameCache::Generation{ 0 };
+bool FLobbyMapNameCache::bBoundAssetRegistryEvents{ false };
+
+FString FLobbyMapNameCache::Resolve(const FPrimaryAssetId& MapID)
+{
+	check(IsInGameThread());
+
+	if (!MapID.IsValid())
+	{
+		return FString();
+	}
+
+	if (const auto* Found{ ResolvedMapNames.Find(MapID) })
+	{
+		return *Found;
+	}
+
+	BindAssetRegistryEvents();
+
+	FAssetData MapAssetData;
+	if (!UAssetManager::Get().GetPrimaryAssetData(MapID, /*out*/ MapAssetData))
+	{
+		return FString();
+	}
+
+	auto MapName{ MapAssetData.PackageName.ToString() };
+	ResolvedMapNames.Emplace(MapID, MapName);
+
+	return MapName;
+}
+
+void FLobbyMapNameCache::Invalidate()
+{
+	ResolvedMapNames.Reset();
+	++Generation;
+}
+
+void FLobbyMapNameCache::Shutdown()
+{
+	if (auto* AssetRegistry{ IAssetRegistry::Get() })
+	{
+		for (const auto& Handle : AssetRegistryDelegateHandles)
+		{
+			AssetRegistry->OnAssetAdded().Remove(Handle);
+			AssetRegistry->OnAssetRemoved().Remove(Handle);
+			AssetRegistry->OnAssetRenamed().Remove(Handle);
+			AssetRegistry->OnFilesLoaded().Remove(Handle);
+		}
+	}
+
+	AssetRegistryDelegateHandles.Reset();
+	ResolvedMapNames.Empty();
+	bBoundAssetRegistryEvents = false;
+}
+
+void FLobbyMapNameCache::BindAssetRegistryEvents()
+{
+	if (bBoundAssetRegistryEvents)
+	{
+		return;
+	}
+
+	auto* AssetRegistry{ IAssetRegistry::Get() };
+	if (!AssetRegistry)
+	{
+		return;
+	}
+
+	bBoundAssetRegistryEvents = true;
+
+	AssetRegistryDelegateHandles.Emplace(AssetRegistry->OnAssetAdded().AddLambda([](const FAssetData&) { Invalidate(); }));
+	AssetRegistryDelegateHandles.Emplace(AssetRegistry->OnAssetRemoved().AddLambda([](const FAssetData&) { Invalidate(); }));
+	AssetRegistryDelegateHandles.Emplace(AssetRegistry->OnAssetRenamed().AddLambda([](const FAssetData&, const FString&) { Invalidate(); }));
+	AssetRegistryDelegateHandles.Emplace(AssetRegistry->OnFilesLoaded().AddStatic(&FLobbyMapNameCache::Invalidate));
+}
+
+
 /////////////////////////////////////////////////////////////////
 // ULobbyCreateRequest
 
@@ -33,48 +116,26 @@ int32 ULobbyCreateRequest::GetMaxPlayers() const
 
 FString ULobbyCreateRequest::GetMapName() const
 {
-	FAssetData MapAssetData;
-	if (UAssetManager::Get().GetPrimaryAssetData(MapID, /*out*/ MapAssetData))
-	{
-		return MapAssetData.PackageName.ToString();
-	}
-	else
-	{
-		return FString();
-	}
+	return FLobbyMapNameCache::Resolve(MapID);
 }
 
 FString ULobbyCreateRequest::ConstructTravelURL() const
 {
-	FString CombinedExtraArgs;
-
-	if (OnlineMode == ELobbyOnlineMode::LAN)
-	{
-		CombinedExtraArgs += TEXT("?bIsLanMatch");
-	}
+	return GetOrBuildCreationTemplate().TravelURL;
+}
 
-	CombinedExtraArgs += TEXT("?listen");
+bool ULobbyCreateRequest::ValidateAndLogErrors(FString& OutError) const
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
 
-	for (const auto& KVP : ExtraArgs)
+	for (const auto& Attr : InitialAttributes)
 	{
-		if (!KVP.Key.IsEmpty())
+		if (!DevSettings->ValidateLobbyAttribute(Attr, false, OutError))
 		{
-			if (KVP.Value.IsEmpty())
-			{
-				CombinedExtraArgs += FString::Printf(TEXT("?%s"), *KVP.Key);
-			}
-			else
-			{
-				CombinedExtraArgs += FString::Printf(TEXT("?%s=%s"), *KVP.Key, *KVP.Value);
-			}
+			return false;
 		}
 	}
 
-	return FString::Printf(TEXT("%s%s"), *GetMapName(), *CombinedExtraArgs);
-}
-
-bool ULobbyCreateRequest::ValidateAndLogErrors(FString& OutError) const
-{
 #if WITH_SERVER_CODE
 	if (GetMapName().IsEmpty())
 	{
@@ -92,7 +153,111 @@ bool ULobbyCreateRequest::ValidateAndLogErrors(FString& OutError) const
 #endif
 }
 
+bool ULobbyCreateRequest::SetInitialAttributeByIndex(int32 SchemaIndex, FLobbyAttribute Attribute)
+{
+	const auto* Entry{ GetDefault<UOnlineDeveloperSettings>()->GetLobbyAttributeSchemaEntry(SchemaIndex) };
+
+	if (!Entry || (Entry->Type != Attribute.GetValueType()))
+	{
+		return false;
+	}
+
+	Attribute.SetAttributeName(Entry->Name);
+
+	for (auto It{ InitialAttributes.CreateIterator() }; It; ++It)
+	{
+		if (It->GetAttributeName() == Entry->Name)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	InitialAttributes.Emplace(MoveTemp(Attribute));
+	return true;
+}
+
 FCreateLobby::Params ULobbyCreateRequest::GenerateCreationParameters() const
+{
+	return GetOrBuildCreationTemplate().Params;
+}
+
+
+bool ULobbyCreateRequest::PrepareCreation(FString& OutError)
+{
+	if (!ValidateAndLogErrors(OutError))
+	{
+		return false;
+	}
+
+	GetOrBuildCreationTemplate();
+
+	return true;
+}
+
+void ULobbyCreateRequest::ResetPreparedCreation()
+{
+	CreationTemplate.Reset();
+}
+
+uint32 ULobbyCreateRequest::GetCreationTemplateKey() const
+{
+	auto Key{ HashCombine(GetDefault<UOnlineDeveloperSettings>()->GetAttributeRedirectGeneration(), FLobbyMapNameCache::GetGeneration()) };
+
+	Key = HashCombine(Key, GetTypeHash(static_cast<uint8>(OnlineMode)));
+	Key = HashCombine(Key, GetTypeHash(static_cast<uint8>(GetJoinPolicy())));
+	Key = HashCombine(Key, GetTypeHash(LocalName));
+	Key = HashCombine(Key, GetTypeHash(SchemaId));
+	Key = HashCombine(Key, GetTypeHash(bPresenceEnabled));
+	Key = HashCombine(Key, GetTypeHash(ModeNameForAdvertisement));
+	Key = HashCombine(Key, GetTypeHash(MapID));
+	Key = HashCombine(Key, GetTypeHash(GetMaxPlayers()));
+
+	// Sets are hashed without depending on their order
+
+	auto HashAttributes
+	{
+		[](const TSet<FLobbyAttribute>& Attributes)
+		{
+			auto Hash{ GetTypeHash(Attributes.Num()) };
+
+			for (const auto& Attr : Attributes)
+			{
+				Hash += HashCombine(GetTypeHash(Attr.GetAttributeName()), Attr.GetValueHash());
+			}
+
+			return Hash;
+		}
+	};
+
+	Key = HashCombine(Key, HashAttributes(InitialAttributes));
+	Key = HashCombine(Key, HashAttributes(InitialUserAttributes));
+
+	// Extra args are hashed in order since they are written to the URL in order
+
+	for (const auto& KVP : ExtraArgs)
+	{
+		Key = HashCombine(Key, HashCombine(GetTypeHash(KVP.Key), GetTypeHash(KVP.Value)));
+	}
+
+	return Key;
+}
+
+const ULobbyCreateRequest::FCreationTemplate& ULobbyCreateRequest::GetOrBuildCreationTemplate() const
+{
+	const auto Key{ GetCreationTemplateKey() };
+
+	if (!CreationTemplate.IsSet() || (CreationTemplate->Key != Key))
+	{
+		auto& NewTemplate{ CreationTemplate.Emplace() };
+		NewTemplate.Key = Key;
+		NewTemplate.Params = BuildCreationParameters();
+		NewTemplate.TravelURL = BuildTravelURL();
+	}
+
+	return CreationTemplate.GetValue();
+}
+
+FCreateLobby::Params ULobbyCreateRequest::BuildCreationParameters() const
 {
 	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
 
@@ -127,3 +292,32 @@ FCreateLobby::Params ULobbyCreateRequest::GenerateCreationParameters() const
 
 	return Prams;
 }
+
+FString ULobbyCreateRequest::BuildTravelURL() const
+{
+	FString CombinedExtraArgs;
+
+	if (OnlineMode == ELobbyOnlineMode::LAN)
+	{
+		CombinedExtraArgs += TEXT("?bIsLanMatch");
+	}
+
+	CombinedExtraArgs += TEXT("?listen");
+
+	for (const auto& KVP : ExtraArgs)
+	{
+		if (!KVP.Key.IsEmpty())
+		{
+			if (KVP.Value.IsEmpty())
+			{
+				CombinedExtraArgs += FString::Printf(TEXT("?%s"), *KVP.Key);
+			}
+			else
+			{
+				CombinedExtraArgs += FString::Printf(TEXT("?%s=%s"), *KVP.Key, *KVP.Value);
+			}
+		}
+	}
+
+	return FString::Printf(TEXT("%s%s"), *GetMapName(), *CombinedExtraArgs);
+}
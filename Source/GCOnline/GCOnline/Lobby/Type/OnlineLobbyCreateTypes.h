@@ -55,6 +55,51 @@ enum class ELobbyJoinablePolicy : uint8
 };
 
 
+////////////////////////////////////////////////////////////////////////
+// Structs
+
+/**
+ * Cache of map package names resolved from primary asset ids
+ * 
+ * Tips:
+ *	Cleared whenever the asset registry reports added, removed or renamed assets.
+ *	Ids that cannot be resolved are not cached, so they are looked up again once the asset has been scanned.
+ */
+struct GCONLINE_API FLobbyMapNameCache
+{
+public:
+	/**
+	 * Returns the package name of the map, will return empty if the primary asset is not found
+	 */
+	static FString Resolve(const FPrimaryAssetId& MapID);
+
+	/**
+	 * Discards all resolved map names
+	 */
+	static void Invalidate();
+
+	/**
+	 * Returns the number of times the cache has been invalidated, used to detect outdated creation templates
+	 */
+	static uint32 GetGeneration() { return Generation; }
+
+	/**
+	 * Unbinds from the asset registry, called when the module shuts down
+	 */
+	static void Shutdown();
+
+private:
+	static void BindAssetRegistryEvents();
+
+private:
+	static TMap<FPrimaryAssetId, FString> ResolvedMapNames;
+	static TArray<FDelegateHandle> AssetRegistryDelegateHandles;
+	static uint32 Generation;
+	static bool bBoundAssetRegistryEvents;
+
+};
+
+
 ////////////////////////////////////////////////////////////////////////
 // Delegates
 
@@ -174,12 +219,69 @@ public:
 	 */
 	virtual bool ValidateAndLogErrors(FString& OutError) const;
 
+	/**
+	 * Sets the initial value of the attribute declared at the index of the lobby attribute schema, returns false if the type does not match
+	 */
+	bool SetInitialAttributeByIndex(int32 SchemaIndex, FLobbyAttribute Attribute);
+
 	/**
 	 * Generate parameters for lobby creation from current settings
 	 */
 	FCreateLobby::Params GenerateCreationParameters() const;
 
 
+	//////////////////////////////////////////////////////
+	// Creation Template
+protected:
+	//
+	// Creation parameters and travel URL built from this request
+	// 
+	// Tips:
+	//	Reused by repeated creates while the key still matches, so they only copy the prebuilt values.
+	//
+	struct FCreationTemplate
+	{
+		uint32 Key{ 0 };
+		FCreateLobby::Params Params;
+		FString TravelURL;
+	};
+
+	mutable TOptional<FCreationTemplate> CreationTemplate;
+
+public:
+	/**
+	 * Validates this request and builds the creation template in advance, so that a following CreateLobby does not build it again
+	 */
+	bool PrepareCreation(FString& OutError);
+
+	/**
+	 * Discards the creation template, it is rebuilt at the next use
+	 */
+	void ResetPreparedCreation();
+
+	/**
+	 * Returns true if the creation template matches the current parameters
+	 */
+	bool IsCreationPrepared() const { return CreationTemplate.IsSet() && (CreationTemplate->Key == GetCreationTemplateKey()); }
+
+protected:
+	/**
+	 * Returns a hash of everything the creation template is built from, used to detect changes to this request
+	 * 
+	 * Tips:
+	 *	Subclasses whose overrides depend on additional state should combine it into the key.
+	 */
+	virtual uint32 GetCreationTemplateKey() const;
+
+	/**
+	 * Returns the creation template matching the current parameters, building it if needed
+	 */
+	const FCreationTemplate& GetOrBuildCreationTemplate() const;
+
+	FCreateLobby::Params BuildCreationParameters() const;
+	FString BuildTravelURL() const;
+
+
 	//////////////////////////////////////////////////////
 	// Create Result
 public:
@@ -36,6 +36,19 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FLobbyJoinCompleteMulticastDelegate, ULobby
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FLobbyJoinCompleteDynamicDelegate, ULobbyJoinRequest*, Lobby, FOnlineServiceResult, Result);
 
 
+/**
+ * Event triggered when the party leader has handed the party off to a game lobby.
+ * The join request is set up to join the game lobby, and has already been started if auto join is enabled in the developer settings.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FLobbyHandoffReceivedDelegate
+										, FName								/*PartyLocalName*/
+										, ULobbyJoinRequest*				/*JoinRequest*/);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FLobbyHandoffReceivedDynamicDelegate
+										, FName								, PartyLocalName
+										, ULobbyJoinRequest*				, JoinRequest);
+
+
 /**
  * Event triggered when a lobby join has completed, after resolving the connect string and prior to the client traveling.
  */
@@ -0,0 +1,104 @@
+// Copyright (C) 2024 owoDra
+
+#include "OnlineLobbyModifyTypes.h"
+
+#include "OnlineDeveloperSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(OnlineLobbyModifyTypes)
+
+
+/////////////////////////////////////////////////////////////////
+// ULobbyModifyTransaction
+
+ULobbyModifyTransaction::ULobbyModifyTransaction(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+
+ULobbyModifyTransaction* ULobbyModifyTransaction::SetJoinPolicy(ELobbyJoinablePolicy InPolicy)
+{
+	bChangeJoinPolicy = true;
+	NewJoinPolicy = InPolicy;
+	return this;
+}
+
+ULobbyModifyTransaction* ULobbyModifyTransaction::SetAttribute(const FLobbyAttribute& InAttribute)
+{
+	SetAttributeInSet(AttrToChange, AttrToRemove, InAttribute);
+	return this;
+}
+
+ULobbyModifyTransaction* ULobbyModifyTransaction::RemoveAttribute(FName InName)
+{
+	RemoveAttributeInSet(AttrToChange, AttrToRemove, InName);
+	return this;
+}
+
+ULobbyModifyTransaction* ULobbyModifyTransaction::SetMemberAttribute(const FLobbyAttribute& InAttribute)
+{
+	SetAttributeInSet(MemberAttrToChange, MemberAttrToRemove, InAttribute);
+	return this;
+}
+
+ULobbyModifyTransaction* ULobbyModifyTransaction::RemoveMemberAttribute(FName InName)
+{
+	RemoveAttributeInSet(MemberAttrToChange, MemberAttrToRemove, InName);
+	return this;
+}
+
+bool ULobbyModifyTransaction::IsEmpty() const
+{
+	return !bChangeJoinPolicy && AttrToChange.IsEmpty() && AttrToRemove.IsEmpty() && MemberAttrToChange.IsEmpty() && MemberAttrToRemove.IsEmpty();
+}
+
+bool ULobbyModifyTransaction::ValidateAndLogErrors(FString& OutError) const
+{
+	if (IsEmpty())
+	{
+		OutError = TEXT("No modifications in the transaction.");
+		return false;
+	}
+
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	for (const auto& Attr : AttrToChange)
+	{
+		if (!DevSettings->ValidateLobbyAttribute(Attr, false, OutError))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+void ULobbyModifyTransaction::SetAttributeInSet(TSet<FLobbyAttribute>& ToChange, TSet<FLobbyAttribute>& ToRemove, const FLobbyAttribute& InAttribute)
+{
+	// Attributes are hashed by name only, so remove the previous entries with the same name first
+
+	RemoveAttributeByName(ToChange, InAttribute.GetAttributeName());
+	RemoveAttributeByName(ToRemove, InAttribute.GetAttributeName());
+
+	ToChange.Emplace(InAttribute);
+}
+
+void ULobbyModifyTransaction::RemoveAttributeInSet(TSet<FLobbyAttribute>& ToChange, TSet<FLobbyAttribute>& ToRemove, FName InName)
+{
+	RemoveAttributeByName(ToChange, InName);
+	RemoveAttributeByName(ToRemove, InName);
+
+	ToRemove.Emplace(FLobbyAttribute(InName));
+}
+
+void ULobbyModifyTransaction::RemoveAttributeByName(TSet<FLobbyAttribute>& Attributes, FName InName)
+{
+	for (auto It{ Attributes.CreateIterator() }; It; ++It)
+	{
+		if (It->GetAttributeName() == InName)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
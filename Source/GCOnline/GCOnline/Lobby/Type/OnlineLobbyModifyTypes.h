@@ -0,0 +1,99 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Type/OnlineLobbyAttributeTypes.h"
+#include "Type/OnlineLobbyCreateTypes.h"
+
+#include "OnlineLobbyModifyTypes.generated.h"
+
+
+////////////////////////////////////////////////////////////////////////
+// Objects
+
+/**
+ * Transaction object that collects lobby modifications to be committed together
+ * 
+ * Tips:
+ *	Join policy, attributes and member attributes are sent with one backend call each at most, all started at the same time,
+ *	and the result is reported once all of them have completed.
+ */
+UCLASS(BlueprintType)
+class GCONLINE_API ULobbyModifyTransaction : public UObject
+{
+	GENERATED_BODY()
+public:
+	ULobbyModifyTransaction(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	///////////////////////////////////////////////
+	// Modify Parameters
+public:
+	//
+	// Whether to change the join policy of the lobby
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	bool bChangeJoinPolicy{ false };
+
+	//
+	// New join policy of the lobby (bChangeJoinPolicy only)
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby", meta = (EditCondition = "bChangeJoinPolicy"))
+	ELobbyJoinablePolicy NewJoinPolicy{ ELobbyJoinablePolicy::PublicAdvertised };
+
+	//
+	// Lobby attributes to be changed or added
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	TSet<FLobbyAttribute> AttrToChange;
+
+	//
+	// Lobby attributes to be removed
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	TSet<FLobbyAttribute> AttrToRemove;
+
+	//
+	// Attributes of the local member to be changed or added
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	TSet<FLobbyAttribute> MemberAttrToChange;
+
+	//
+	// Attributes of the local member to be removed
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	TSet<FLobbyAttribute> MemberAttrToRemove;
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Lobby")
+	ULobbyModifyTransaction* SetJoinPolicy(ELobbyJoinablePolicy InPolicy);
+
+	UFUNCTION(BlueprintCallable, Category = "Lobby")
+	ULobbyModifyTransaction* SetAttribute(const FLobbyAttribute& InAttribute);
+
+	UFUNCTION(BlueprintCallable, Category = "Lobby")
+	ULobbyModifyTransaction* RemoveAttribute(FName InName);
+
+	UFUNCTION(BlueprintCallable, Category = "Lobby")
+	ULobbyModifyTransaction* SetMemberAttribute(const FLobbyAttribute& InAttribute);
+
+	UFUNCTION(BlueprintCallable, Category = "Lobby")
+	ULobbyModifyTransaction* RemoveMemberAttribute(FName InName);
+
+	/**
+	 * Returns true if there are no modifications in this transaction
+	 */
+	UFUNCTION(BlueprintPure, Category = "Lobby")
+	bool IsEmpty() const;
+
+	/**
+	 * Returns true if this transaction is valid, returns false and logs errors if it is not
+	 */
+	virtual bool ValidateAndLogErrors(FString& OutError) const;
+
+protected:
+	static void SetAttributeInSet(TSet<FLobbyAttribute>& ToChange, TSet<FLobbyAttribute>& ToRemove, const FLobbyAttribute& InAttribute);
+	static void RemoveAttributeInSet(TSet<FLobbyAttribute>& ToChange, TSet<FLobbyAttribute>& ToRemove, FName InName);
+	static void RemoveAttributeByName(TSet<FLobbyAttribute>& Attributes, FName InName);
+
+};
@@ -0,0 +1,148 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Type/OnlineLobbySearchTypes.h"
+
+#include "OnlineLobbyOperationTypes.generated.h"
+
+
+/////////////////////////////////////////////////////
+// Enums
+
+/**
+ * Type of lobby operation in progress
+ */
+UENUM()
+enum class ELobbyOperationType : uint8
+{
+	Create,
+	Search,
+	Join,
+	Modify,
+	Leave
+};
+
+
+/////////////////////////////////////////////////////
+// Structs
+
+/**
+ * Key to identify a lobby operation in progress
+ *
+ * Tips:
+ *	Searches are not bound to any lobby, so they are registered with NAME_None as LocalName.
+ */
+USTRUCT()
+struct GCONLINE_API FLobbyOperationKey
+{
+	GENERATED_BODY()
+public:
+	FLobbyOperationKey() = default;
+	FLobbyOperationKey(const FName& InLocalName, int32 InOperationId) : LocalName(InLocalName), OperationId(InOperationId) {}
+
+public:
+	//
+	// Local name of the lobby targeted by the operation
+	//
+	UPROPERTY()
+	FName LocalName{ NAME_None };
+
+	//
+	// Unique id assigned when the operation was started
+	//
+	UPROPERTY()
+	int32 OperationId{ INDEX_NONE };
+
+public:
+	bool IsValid() const { return OperationId != INDEX_NONE; }
+
+	bool operator==(const FLobbyOperationKey& Other) const { return (LocalName == Other.LocalName) && (OperationId == Other.OperationId); }
+
+	friend FORCEINLINE uint32 GetTypeHash(const FLobbyOperationKey& Key) { return HashCombine(GetTypeHash(Key.LocalName), GetTypeHash(Key.OperationId)); }
+
+};
+
+
+/**
+ * Caller attached to a lobby search already in progress with equivalent parameters
+ */
+USTRUCT()
+struct GCONLINE_API FLobbySearchFollower
+{
+	GENERATED_BODY()
+public:
+	FLobbySearchFollower() = default;
+	FLobbySearchFollower(ULobbySearchRequest* InRequest, const FLobbySearchCompleteDelegate& InDelegate) : Request(InRequest), Delegate(InDelegate) {}
+
+public:
+	UPROPERTY()
+	TObjectPtr<ULobbySearchRequest> Request{ nullptr };
+
+	FLobbySearchCompleteDelegate Delegate;
+
+};
+
+
+/**
+ * Data of a lobby operation in progress
+ */
+USTRUCT()
+struct GCONLINE_API FLobbyOperation
+{
+	GENERATED_BODY()
+public:
+	FLobbyOperation() = default;
+	FLobbyOperation(ELobbyOperationType InType, UObject* InRequest) : Type(InType), Request(InRequest) {}
+
+public:
+	//
+	// Type of this operation
+	//
+	UPROPERTY()
+	ELobbyOperationType Type{ ELobbyOperationType::Create };
+
+	//
+	// Request object that started this operation
+	//
+	UPROPERTY()
+	TObjectPtr<UObject> Request{ nullptr };
+
+	//
+	// Whether the completion is broadcast to the subsystem events, disabled when the caller notifies a combined result
+	//
+	UPROPERTY()
+	bool bBroadcastComplete{ true };
+
+	//
+	// Time at which the operation times out, 0 if it has no deadline
+	//
+	UPROPERTY()
+	double Deadline{ 0.0 };
+
+	//
+	// Completes the operation with the error and cancels the operation of the online service, set once the operation has been started
+	//
+	TFunction<void(const FOnlineError&)> Abort;
+
+	//
+	// Hash of the canonical search parameters and local user, used to coalesce equivalent searches and as the key of the search result cache (Search only)
+	//
+	UPROPERTY()
+	uint32 SearchHash{ 0 };
+
+	//
+	// Canonical search parameters and local user, compared when the hash matches so that colliding searches are never coalesced (Search only)
+	//
+	UPROPERTY()
+	FString SearchKey;
+
+	FAccountId SearchAccountId;
+
+	//
+	// Callers waiting for the result of this search in addition to the request that started it (Search only)
+	//
+	UPROPERTY()
+	TArray<FLobbySearchFollower> SearchFollowers;
+
+};
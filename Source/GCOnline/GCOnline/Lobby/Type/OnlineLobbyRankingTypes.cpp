@@ -0,0 +1,230 @@
+// Copyright (C) 2024 owoDra
+
+#include "OnlineLobbyRankingTypes.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(OnlineLobbyRankingTypes)
+
+
+/////////////////////////////////////////////////////////////////
+// FLobbyCandidateSnapshot
+
+void FLobbyCandidateSnapshot::Build(const TArray<FLobbyView>& Views, const TMap<FLobbyId, FLobbyHistoryEntry>& History, double CurrentTime)
+{
+	const auto NumViews{ Views.Num() };
+
+	Lobbies.Reset(NumViews);
+	OpenSlots.Reset(NumViews);
+	MaxMembers.Reset(NumViews);
+	NumJoinFailures.Reset(NumViews);
+	SecondsSinceJoinFailure.Reset(NumViews);
+	LatencyMs.Reset(NumViews);
+
+	for (const auto& View : Views)
+	{
+		const auto* Lobby{ View.GetLobby().Get() };
+		const auto* HistoryEntry{ Lobby ? History.Find(Lobby->LobbyId) : nullptr };
+
+		Lobbies.Emplace(Lobby);
+		OpenSlots.Emplace(View.GetNumOpenSlot());
+		MaxMembers.Emplace(View.GetMaxMembers());
+		NumJoinFailures.Emplace(HistoryEntry ? HistoryEntry->NumJoinFailures : 0);
+		SecondsSinceJoinFailure.Emplace((HistoryEntry && HistoryEntry->NumJoinFailures > 0) ? static_cast<float>(CurrentTime - HistoryEntry->LastJoinFailureTime) : MAX_flt);
+		LatencyMs.Emplace(HistoryEntry ? HistoryEntry->LatencyMs : -1.0f);
+	}
+
+	Scores.Reset(NumViews);
+	Scores.SetNumZeroed(NumViews);
+}
+
+
+/////////////////////////////////////////////////////////////////
+// ULobbyScorer
+
+ULobbyScorer::ULobbyScorer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+
+void ULobbyScorer_OpenSlots::ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const
+{
+	for (auto Index{ 0 }; Index < Snapshot.Num(); ++Index)
+	{
+		const auto Max{ Snapshot.MaxMembers[Index] };
+
+		OutScores[Index] = (Max > 0) ? FMath::Clamp(static_cast<float>(Snapshot.OpenSlots[Index]) / Max, 0.0f, 1.0f) : 0.0f;
+	}
+}
+
+
+void ULobbyScorer_AttributeAffinity::ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const
+{
+	if (PreferredAttributes.IsEmpty())
+	{
+		return;
+	}
+
+	// Resolve the names and values once for all candidates
+
+	TArray<TPair<FLobbyAttributeHandle, FSchemaVariant>, TInlineAllocator<8>> Preferred;
+	Preferred.Reserve(PreferredAttributes.Num());
+
+	for (const auto& Attribute : PreferredAttributes)
+	{
+		Preferred.Emplace(FLobbyAttributeHandle::Resolve(Attribute.GetAttributeName()), Attribute.ToSchemaVariant());
+	}
+
+	for (auto Index{ 0 }; Index < Snapshot.Num(); ++Index)
+	{
+		const auto* Lobby{ Snapshot.Lobbies[Index] };
+		if (!Lobby)
+		{
+			continue;
+		}
+
+		auto NumMatched{ 0 };
+
+		for (const auto& KVP : Preferred)
+		{
+			const auto* Value{ Lobby->Attributes.Find(KVP.Key.GetServiceName()) };
+
+			if (Value && (*Value == KVP.Value))
+			{
+				++NumMatched;
+			}
+		}
+
+		OutScores[Index] = static_cast<float>(NumMatched) / Preferred.Num();
+	}
+}
+
+
+void ULobbyScorer_FailureHistory::ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const
+{
+	for (auto Index{ 0 }; Index < Snapshot.Num(); ++Index)
+	{
+		const auto bRecentlyFailed{ Snapshot.SecondsSinceJoinFailure[Index] < RecentWindow };
+
+		OutScores[Index] = bRecentlyFailed ? 1.0f / (1.0f + Snapshot.NumJoinFailures[Index]) : 1.0f;
+	}
+}
+
+
+void ULobbyScorer_Latency::ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const
+{
+	for (auto Index{ 0 }; Index < Snapshot.Num(); ++Index)
+	{
+		const auto Latency{ Snapshot.LatencyMs[Index] };
+
+		OutScores[Index] = (Latency < 0.0f) ? UnmeasuredScore : 1.0f - FMath::Clamp(Latency / MaxLatencyMs, 0.0f, 1.0f);
+	}
+}
+
+
+/////////////////////////////////////////////////////////////////
+// ULobbyRankingPolicy
+
+ULobbyRankingPolicy::ULobbyRankingPolicy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	Scorers.Emplace(CreateDefaultSubobject<ULobbyScorer_OpenSlots>(TEXT("OpenSlots")));
+	Scorers.Emplace(CreateDefaultSubobject<ULobbyScorer_FailureHistory>(TEXT("FailureHistory")));
+	Scorers.Emplace(CreateDefaultSubobject<ULobbyScorer_Latency>(TEXT("Latency")));
+}
+
+
+void ULobbyRankingPolicy::ScoreCandidates(FLobbyCandidateSnapshot& Snapshot) const
+{
+	const auto NumCandidates{ Snapshot.Num() };
+
+	Snapshot.Scores.Reset(NumCandidates);
+	Snapshot.Scores.SetNumZeroed(NumCandidates);
+
+	TArray<float> ScorerScores;
+	ScorerScores.SetNumUninitialized(NumCandidates);
+
+	for (const auto& Scorer : Scorers)
+	{
+		if (!Scorer || (Scorer->Weight <= 0.0f))
+		{
+			continue;
+		}
+
+		FMemory::Memzero(ScorerScores.GetData(), ScorerScores.Num() * sizeof(float));
+
+		Scorer->ScoreCandidates(Snapshot, ScorerScores);
+
+		for (auto Index{ 0 }; Index < NumCandidates; ++Index)
+		{
+			Snapshot.Scores[Index] += Scorer->Weight * ScorerScores[Index];
+		}
+	}
+}
+
+TArray<int32> ULobbyRankingPolicy::RankCandidates(FLobbyCandidateSnapshot& Snapshot) const
+{
+	ScoreCandidates(Snapshot);
+
+	// Order candidates by score
+
+	TArray<int32> Ordered;
+	Ordered.Reserve(Snapshot.Num());
+
+	for (auto Index{ 0 }; Index < Snapshot.Num(); ++Index)
+	{
+		if (!Snapshot.Lobbies[Index] || (bExcludeFullLobbies && (Snapshot.OpenSlots[Index] <= 0)))
+		{
+			continue;
+		}
+
+		Ordered.Emplace(Index);
+	}
+
+	Ordered.Sort([&Snapshot](int32 A, int32 B) { return Snapshot.Scores[A] > Snapshot.Scores[B]; });
+
+	// Shuffle the top candidates by weighted random so that clients do not all choose the same lobby
+
+	const auto NumTop{ FMath::Min(NumTopCandidates, Ordered.Num()) };
+
+	if ((NumTop > 1) && (SelectionTemperature > 0.0f))
+	{
+		const auto BestScore{ Snapshot.Scores[Ordered[0]] };
+
+		TArray<int32, TInlineAllocator<8>> Pool(Ordered.GetData(), NumTop);
+		TArray<float, TInlineAllocator<8>> Weights;
+
+		for (const auto& Index : Pool)
+		{
+			Weights.Emplace(FMath::Exp((Snapshot.Scores[Index] - BestScore) / SelectionTemperature));
+		}
+
+		for (auto Slot{ 0 }; Slot < NumTop; ++Slot)
+		{
+			auto TotalWeight{ 0.0f };
+			for (const auto& Weight : Weights)
+			{
+				TotalWeight += Weight;
+			}
+
+			auto Pick{ FMath::FRand() * TotalWeight };
+			auto Picked{ Pool.Num() - 1 };
+
+			for (auto PoolIndex{ 0 }; PoolIndex < Pool.Num(); ++PoolIndex)
+			{
+				Pick -= Weights[PoolIndex];
+
+				if (Pick <= 0.0f)
+				{
+					Picked = PoolIndex;
+					break;
+				}
+			}
+
+			Ordered[Slot] = Pool[Picked];
+			Pool.RemoveAtSwap(Picked);
+			Weights.RemoveAtSwap(Picked);
+		}
+	}
+
+	return Ordered;
+}
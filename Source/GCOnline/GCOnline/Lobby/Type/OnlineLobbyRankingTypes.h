@@ -0,0 +1,260 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Type/OnlineLobbyAttributeTypes.h"
+#include "Type/OnlineLobbyViewTypes.h"
+
+#include "Online/Lobbies.h"
+
+#include "OnlineLobbyRankingTypes.generated.h"
+
+using namespace UE::Online;
+
+
+/////////////////////////////////////////////////////
+// Structs
+
+/**
+ * What the local client has observed about a lobby, used to rank lobbies in later searches
+ */
+struct GCONLINE_API FLobbyHistoryEntry
+{
+public:
+	FLobbyHistoryEntry() = default;
+
+public:
+	//
+	// Number of times joining this lobby has failed
+	//
+	int32 NumJoinFailures{ 0 };
+
+	//
+	// Time in seconds of the last failed join
+	//
+	double LastJoinFailureTime{ 0.0 };
+
+	//
+	// Measured latency in milliseconds, negative if not measured
+	//
+	float LatencyMs{ -1.0f };
+
+	//
+	// Time in seconds of the last update to this entry
+	//
+	double LastUpdateTime{ 0.0 };
+
+public:
+	bool HasLatency() const { return LatencyMs >= 0.0f; }
+
+};
+
+
+/**
+ * Flat snapshot of lobby search results used for scoring
+ * 
+ * Tips:
+ *	Each value is stored in its own array so that scorers only touch the data they need.
+ *	Lobby pointers refer to the views the snapshot was built from, so the views must outlive the snapshot.
+ */
+struct GCONLINE_API FLobbyCandidateSnapshot
+{
+public:
+	FLobbyCandidateSnapshot() = default;
+
+public:
+	TArray<const FLobby*> Lobbies;
+	TArray<int32> OpenSlots;
+	TArray<int32> MaxMembers;
+
+	//
+	// Number of failed joins and seconds since the last one, MAX_flt if never failed
+	//
+	TArray<int32> NumJoinFailures;
+	TArray<float> SecondsSinceJoinFailure;
+
+	//
+	// Measured latency in milliseconds, negative if not measured
+	//
+	TArray<float> LatencyMs;
+
+	//
+	// Accumulated score of each candidate
+	//
+	TArray<float> Scores;
+
+public:
+	int32 Num() const { return Lobbies.Num(); }
+
+	void Build(const TArray<FLobbyView>& Views, const TMap<FLobbyId, FLobbyHistoryEntry>& History, double CurrentTime);
+
+};
+
+
+/////////////////////////////////////////////////////
+// Scorers
+
+/**
+ * Base class of a scoring step used to rank lobby candidates
+ */
+UCLASS(Abstract, EditInlineNew, DefaultToInstanced, CollapseCategories)
+class GCONLINE_API ULobbyScorer : public UObject
+{
+	GENERATED_BODY()
+public:
+	ULobbyScorer(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+public:
+	//
+	// Weight of this score in the total score of a candidate
+	//
+	UPROPERTY(EditAnywhere, Category = "Scorer", meta = (ClampMin = 0.0))
+	float Weight{ 1.0f };
+
+public:
+	/**
+	 * Writes a score between 0 and 1 for each candidate of the snapshot
+	 */
+	virtual void ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const {}
+
+};
+
+
+/**
+ * Prefers lobbies with more open slots relative to their size
+ */
+UCLASS(meta = (DisplayName = "Open Slots"))
+class GCONLINE_API ULobbyScorer_OpenSlots : public ULobbyScorer
+{
+	GENERATED_BODY()
+public:
+	virtual void ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const override;
+
+};
+
+
+/**
+ * Prefers lobbies whose attributes match the preferred values
+ */
+UCLASS(meta = (DisplayName = "Attribute Affinity"))
+class GCONLINE_API ULobbyScorer_AttributeAffinity : public ULobbyScorer
+{
+	GENERATED_BODY()
+public:
+	//
+	// Attribute values that the lobby is preferred to have
+	//
+	UPROPERTY(EditAnywhere, Category = "Scorer")
+	TArray<FLobbyAttribute> PreferredAttributes;
+
+public:
+	virtual void ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const override;
+
+};
+
+
+/**
+ * Avoids lobbies that recently failed to be joined
+ */
+UCLASS(meta = (DisplayName = "Failure History"))
+class GCONLINE_API ULobbyScorer_FailureHistory : public ULobbyScorer
+{
+	GENERATED_BODY()
+public:
+	//
+	// Time in seconds that a failed join lowers the score of the lobby
+	//
+	UPROPERTY(EditAnywhere, Category = "Scorer", meta = (ClampMin = 0.0, Units = "s"))
+	float RecentWindow{ 60.0f };
+
+public:
+	virtual void ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const override;
+
+};
+
+
+/**
+ * Prefers lobbies with lower measured latency
+ */
+UCLASS(meta = (DisplayName = "Latency"))
+class GCONLINE_API ULobbyScorer_Latency : public ULobbyScorer
+{
+	GENERATED_BODY()
+public:
+	//
+	// Latency in milliseconds at which the score reaches 0
+	//
+	UPROPERTY(EditAnywhere, Category = "Scorer", meta = (ClampMin = 1.0, Units = "ms"))
+	float MaxLatencyMs{ 250.0f };
+
+	//
+	// Score of lobbies whose latency has not been measured
+	//
+	UPROPERTY(EditAnywhere, Category = "Scorer", meta = (ClampMin = 0.0, ClampMax = 1.0))
+	float UnmeasuredScore{ 0.5f };
+
+public:
+	virtual void ScoreCandidates(const FLobbyCandidateSnapshot& Snapshot, TArrayView<float> OutScores) const override;
+
+};
+
+
+/////////////////////////////////////////////////////
+// Policy
+
+/**
+ * Pipeline of scorers that ranks lobby search results
+ * 
+ * Tips:
+ *	Create a subclass (also in Blueprint) to change the scorers and set it in the developer settings.
+ */
+UCLASS(Blueprintable, EditInlineNew, DefaultToInstanced)
+class GCONLINE_API ULobbyRankingPolicy : public UObject
+{
+	GENERATED_BODY()
+public:
+	ULobbyRankingPolicy(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+public:
+	//
+	// Scorers whose weighted scores are summed to the total score of a candidate
+	//
+	UPROPERTY(EditAnywhere, Instanced, Category = "Ranking")
+	TArray<TObjectPtr<ULobbyScorer>> Scorers;
+
+	//
+	// Number of best candidates that are chosen randomly between, weighted by their score
+	//
+	UPROPERTY(EditAnywhere, Category = "Ranking", meta = (ClampMin = 1))
+	int32 NumTopCandidates{ 3 };
+
+	//
+	// How much a lower score reduces the chance of a top candidate to be chosen
+	// 
+	// Tips:
+	//	Set to 0 to always choose the candidate with the best score.
+	//
+	UPROPERTY(EditAnywhere, Category = "Ranking", meta = (ClampMin = 0.0))
+	float SelectionTemperature{ 0.1f };
+
+	//
+	// Whether to exclude lobbies without open slots from the candidates
+	//
+	UPROPERTY(EditAnywhere, Category = "Ranking")
+	bool bExcludeFullLobbies{ true };
+
+public:
+	/**
+	 * Fills the scores of the snapshot with the weighted sum of all scorers
+	 */
+	virtual void ScoreCandidates(FLobbyCandidateSnapshot& Snapshot) const;
+
+	/**
+	 * Returns the candidate indices in the order they should be tried
+	 * 
+	 * Tips:
+	 *	The top candidates are ordered by weighted random, the rest by score.
+	 */
+	virtual TArray<int32> RankCandidates(FLobbyCandidateSnapshot& Snapshot) const;
+
+};
@@ -17,6 +17,71 @@ ULobbyResult::ULobbyResult(const FObjectInitializer& ObjectInitializer)
 }
 
 
+void ULobbyResult::InitializeResult(const TSharedPtr<const FLobby>& InLobby)
+{
+	Lobby = InLobby;
+
+	// Build the snapshot of the schema attributes
+
+	const auto& Schema{ GetDefault<UOnlineDeveloperSettings>()->GetLobbyAttributeSchema() };
+
+	SchemaAttributes.Reset(Schema.Num());
+	SchemaAttributes.SetNum(Schema.Num());
+
+	if (Lobby)
+	{
+		for (auto Index{ 0 }; Index < Schema.Num(); ++Index)
+		{
+			if (Schema[Index].ServiceName.IsNone())
+			{
+				continue;
+			}
+
+			const auto* VariantValue{ Lobby->Attributes.Find(Schema[Index].ServiceName) };
+
+			if (VariantValue && Schema[Index].MatchesValueType(*VariantValue))
+			{
+				SchemaAttributes[Index] = *VariantValue;
+			}
+		}
+	}
+}
+
+ULobbyResult* ULobbyResult::CreateFromView(UObject* Outer, const FLobbyView& InView)
+{
+	auto* NewResult{ NewObject<ULobbyResult>(Outer) };
+	NewResult->InitializeResult(InView);
+
+	return NewResult;
+}
+
+bool ULobbyResult::HasLobbyStateChanged(const FLobby& InLobby) const
+{
+	if (!Lobby)
+	{
+		return true;
+	}
+
+	if ((Lobby->OwnerAccountId != InLobby.OwnerAccountId) || 
+		(Lobby->JoinPolicy != InLobby.JoinPolicy) || 
+		(Lobby->MaxMembers != InLobby.MaxMembers) || 
+		(Lobby->Members.Num() != InLobby.Members.Num()))
+	{
+		return true;
+	}
+
+	for (const auto& KVP : InLobby.Members)
+	{
+		if (!Lobby->Members.Contains(KVP.Key))
+		{
+			return true;
+		}
+	}
+
+	return !Lobby->Attributes.OrderIndependentCompareEqual(InLobby.Attributes);
+}
+
+
 // Lobby Info
 
 FName ULobbyResult::GetLocalName() const
@@ -101,6 +166,21 @@ bool ULobbyResult::GetLobbyAttributeAsBoolean(FName Key, bool& OutValue) const
 	return false;
 }
 
+const FSchemaVariant* ULobbyResult::FindLobbyAttribute(const FLobbyAttributeHandle& Handle) const
+{
+	return ensure(Lobby) ? Lobby->Attributes.Find(Handle.GetServiceName()) : nullptr;
+}
+
+const FSchemaVariant* ULobbyResult::GetLobbyAttributeByIndex(int32 SchemaIndex) const
+{
+	if (SchemaAttributes.IsValidIndex(SchemaIndex) && (SchemaAttributes[SchemaIndex].GetType() != ESchemaAttributeType::None))
+	{
+		return &SchemaAttributes[SchemaIndex];
+	}
+
+	return nullptr;
+}
+
 FName ULobbyResult::ResolveAttributeKey(const FName& Key) const
 {
 	const auto* DevSetting{ GetDefault<UOnlineDeveloperSettings>() };
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "Type/OnlineServiceResultTypes.h"
+#include "Type/OnlineServiceContextTypes.h"
 #include "Type/OnlineLobbyAttributeTypes.h"
+#include "Type/OnlineLobbyViewTypes.h"
 
 #include "Online/Lobbies.h"
 
@@ -32,11 +34,46 @@ protected:
 	//
 	TSharedPtr<const FLobby> Lobby;
 
+	//
+	// Snapshot of the attributes declared in the lobby attribute schema, indexed by schema index
+	// 
+	// Tips:
+	//	Attributes that are not set or have a different type from the schema are left empty.
+	//
+	TArray<FSchemaVariant> SchemaAttributes;
+
+	//
+	// Service context in which the lobby was found or joined
+	//
+	UPROPERTY(Transient)
+	EOnlineServiceContext ServiceContext{ EOnlineServiceContext::Default };
+
 public:
-	virtual void InitializeResult(const TSharedPtr<const FLobby>& InLobby) { Lobby = InLobby; }
+	virtual void InitializeResult(const TSharedPtr<const FLobby>& InLobby);
+	void InitializeResult(const FLobbyView& InView) { InitializeResult(InView.GetLobby()); }
 
 	const TSharedPtr<const FLobby>& GetLobby() const { return Lobby; }
 
+	UFUNCTION(BlueprintPure, Category = "Lobby")
+	EOnlineServiceContext GetServiceContext() const { return ServiceContext; }
+
+	void SetServiceContext(EOnlineServiceContext InContext) { ServiceContext = InContext; }
+
+	/**
+	 * Creates a lightweight view of the lobby for native code
+	 */
+	FLobbyView MakeView() const { return FLobbyView(Lobby); }
+
+	/**
+	 * Creates a new result object wrapping the lobby of the view
+	 */
+	static ULobbyResult* CreateFromView(UObject* Outer, const FLobbyView& InView);
+
+	/**
+	 * Returns true if the lobby has a different state (owner, policy, members or attributes) from the current snapshot
+	 */
+	virtual bool HasLobbyStateChanged(const FLobby& InLobby) const;
+
 
 	///////////////////////////////////////////////////
 	// Lobby Info
@@ -73,6 +110,16 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Lobby")
 	bool GetLobbyAttributeAsBoolean(FName Key, bool& OutValue) const;
 
+	/**
+	 * Returns the attribute value for a resolved attribute handle, will return null if there is no attribute
+	 */
+	const FSchemaVariant* FindLobbyAttribute(const FLobbyAttributeHandle& Handle) const;
+
+	/**
+	 * Returns the attribute value by the index in the lobby attribute schema, will return null if there is no valid attribute
+	 */
+	const FSchemaVariant* GetLobbyAttributeByIndex(int32 SchemaIndex) const;
+
 protected:
 	/**
 	 * Convert to a key with redirection set in DevSetting (Project => OnlineService)
@@ -0,0 +1,93 @@
+// Copyright (C) 2024 owoDra
+
+#include "OnlineLobbyRosterTypes.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(OnlineLobbyRosterTypes)
+
+
+/////////////////////////////////////////////////////////////////
+// FLobbyRosterDelta
+
+void FLobbyRosterDelta::MarkAdded(const FAccountId& AccountId)
+{
+	const FUniqueNetIdRepl NetId{ AccountId };
+
+	// Left and joined again in the same frame
+
+	if (RemovedMembers.Remove(NetId) > 0)
+	{
+		ChangedMembers.AddUnique(NetId);
+		return;
+	}
+
+	AddedMembers.AddUnique(NetId);
+}
+
+void FLobbyRosterDelta::MarkRemoved(const FAccountId& AccountId)
+{
+	const FUniqueNetIdRepl NetId{ AccountId };
+
+	ChangedMembers.Remove(NetId);
+
+	// Joined and left in the same frame
+
+	if (AddedMembers.Remove(NetId) > 0)
+	{
+		return;
+	}
+
+	RemovedMembers.AddUnique(NetId);
+}
+
+void FLobbyRosterDelta::MarkChanged(const FAccountId& AccountId)
+{
+	const FUniqueNetIdRepl NetId{ AccountId };
+
+	if (!AddedMembers.Contains(NetId))
+	{
+		ChangedMembers.AddUnique(NetId);
+	}
+}
+
+
+/////////////////////////////////////////////////////////////////
+// FLobbyRoster
+
+void FLobbyRoster::Reset(const FLobby& InLobby)
+{
+	Members.Reset();
+	Members.Reserve(InLobby.Members.Num());
+	NumLocalMembers = 0;
+
+	for (const auto& KVP : InLobby.Members)
+	{
+		AddOrUpdate(KVP.Value);
+	}
+}
+
+bool FLobbyRoster::AddOrUpdate(const TSharedRef<const FLobbyMember>& InMember)
+{
+	if (auto* Found{ Members.Find(InMember->AccountId) })
+	{
+		NumLocalMembers += (InMember->bIsLocalMember ? 1 : 0) - (Found->IsLocalMember() ? 1 : 0);
+		Found->Member = InMember;
+		Found->Attributes = InMember->Attributes;
+		return false;
+	}
+
+	Members.Emplace(InMember->AccountId, FLobbyRosterEntry(InMember));
+	NumLocalMembers += InMember->bIsLocalMember ? 1 : 0;
+	return true;
+}
+
+bool FLobbyRoster::Remove(const FAccountId& AccountId)
+{
+	FLobbyRosterEntry Removed;
+	if (Members.RemoveAndCopyValue(AccountId, Removed))
+	{
+		NumLocalMembers -= Removed.IsLocalMember() ? 1 : 0;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameFramework/OnlineReplStructs.h"
+
+#include "Online/Lobbies.h"
+
+#include "OnlineLobbyRosterTypes.generated.h"
+
+using namespace UE::Online;
+
+
+/////////////////////////////////////////////////////
+// Structs
+
+/**
+ * Changes of the members of a lobby since the last notification
+ * 
+ * Tips:
+ *	Changes made within the same frame are merged, a member who joined and left in the same frame is not listed.
+ */
+USTRUCT(BlueprintType)
+struct GCONLINE_API FLobbyRosterDelta
+{
+	GENERATED_BODY()
+public:
+	FLobbyRosterDelta() = default;
+	FLobbyRosterDelta(const FName& InLocalName) : LocalName(InLocalName) {}
+
+public:
+	//
+	// Local name of the lobby
+	//
+	UPROPERTY(BlueprintReadOnly)
+	FName LocalName{ NAME_None };
+
+	//
+	// Members who joined the lobby
+	//
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FUniqueNetIdRepl> AddedMembers;
+
+	//
+	// Members who left the lobby
+	//
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FUniqueNetIdRepl> RemovedMembers;
+
+	//
+	// Members whose attributes have changed
+	//
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FUniqueNetIdRepl> ChangedMembers;
+
+public:
+	bool IsEmpty() const { return AddedMembers.IsEmpty() && RemovedMembers.IsEmpty() && ChangedMembers.IsEmpty(); }
+
+	void MarkAdded(const FAccountId& AccountId);
+	void MarkRemoved(const FAccountId& AccountId);
+	void MarkChanged(const FAccountId& AccountId);
+
+};
+
+
+/**
+ * Member entry of a lobby roster
+ */
+struct GCONLINE_API FLobbyRosterEntry
+{
+public:
+	FLobbyRosterEntry() = default;
+	FLobbyRosterEntry(const TSharedRef<const FLobbyMember>& InMember) : Member(InMember), Attributes(InMember->Attributes) {}
+
+public:
+	//
+	// Member data on online service
+	//
+	TSharedPtr<const FLobbyMember> Member;
+
+	//
+	// Copy of the member attributes at the last update, used to detect changed attributes
+	//
+	TMap<FSchemaAttributeId, FSchemaVariant> Attributes;
+
+public:
+	bool IsLocalMember() const { return Member ? Member->bIsLocalMember : false; }
+	const TMap<FSchemaAttributeId, FSchemaVariant>& GetAttributes() const { return Attributes; }
+
+};
+
+
+/**
+ * Index of the members of a joined lobby by account id
+ * 
+ * Tips:
+ *	Built once when the lobby is joined and updated incrementally by member events.
+ */
+struct GCONLINE_API FLobbyRoster
+{
+public:
+	FLobbyRoster() = default;
+
+protected:
+	TMap<FAccountId, FLobbyRosterEntry> Members;
+
+	int32 NumLocalMembers{ 0 };
+
+public:
+	/**
+	 * Rebuilds all entries from the lobby
+	 */
+	void Reset(const FLobby& InLobby);
+
+	/**
+	 * Adds the member or replaces its snapshot, returns true if the member was newly added
+	 */
+	bool AddOrUpdate(const TSharedRef<const FLobbyMember>& InMember);
+
+	/**
+	 * Removes the member, returns true if the member was in the roster
+	 */
+	bool Remove(const FAccountId& AccountId);
+
+	const FLobbyRosterEntry* Find(const FAccountId& AccountId) const { return Members.Find(AccountId); }
+	bool Contains(const FAccountId& AccountId) const { return Members.Contains(AccountId); }
+
+	const TMap<FAccountId, FLobbyRosterEntry>& GetMembers() const { return Members; }
+
+	int32 Num() const { return Members.Num(); }
+	int32 NumLocal() const { return NumLocalMembers; }
+	int32 NumRemote() const { return Members.Num() - NumLocalMembers; }
+
+};
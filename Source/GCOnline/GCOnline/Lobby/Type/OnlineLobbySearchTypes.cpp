@@ -7,6 +7,39 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(OnlineLobbySearchTypes)
 
 
+/////////////////////////////////////////////////////////////////
+// FLobbySearchWideningStep
+
+void FLobbySearchWideningStep::ApplyTo(TSet<FLobbyAttributeFilter>& InOutFilters) const
+{
+	auto RemoveFiltersByName
+	{
+		[&InOutFilters](const FName& Name)
+		{
+			for (auto It{ InOutFilters.CreateIterator() }; It; ++It)
+			{
+				if (It->Attribute.GetAttributeName() == Name)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+	};
+
+	for (const auto& Name : FiltersToRemove)
+	{
+		RemoveFiltersByName(Name);
+	}
+
+	for (const auto& Filter : FiltersToSet)
+	{
+		RemoveFiltersByName(Filter.Attribute.GetAttributeName());
+
+		InOutFilters.Emplace(Filter);
+	}
+}
+
+
 /////////////////////////////////////////////////////////////////
 // ULobbySearchRequest
 
@@ -34,3 +67,117 @@ FFindLobbies::Params ULobbySearchRequest::GenerateFindParameters() const
 
 	return Prams;
 }
+
+uint32 ULobbySearchRequest::GetCanonicalHash() const
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	// Hash each filter individually and sort them so that the order in the set does not matter
+
+	TArray<uint32, TInlineAllocator<8>> FilterHashes;
+	FilterHashes.Reserve(Filters.Num());
+
+	for (const auto& Filter : Filters)
+	{
+		auto FilterHash{ GetTypeHash(DevSettings->RedirectLobbyAttribute_ToOnlineService(Filter.Attribute.GetAttributeName())) };
+		FilterHash = HashCombine(FilterHash, GetTypeHash(static_cast<uint8>(Filter.ComparisonOp)));
+		FilterHash = HashCombine(FilterHash, GetTypeHash(static_cast<uint8>(Filter.Attribute.GetValueType())));
+		FilterHash = HashCombine(FilterHash, Filter.Attribute.GetValueHash());
+
+		FilterHashes.Emplace(FilterHash);
+	}
+
+	FilterHashes.Sort();
+
+	auto Hash{ HashCombine(GetTypeHash(MaxResult), GetTypeHash(static_cast<uint8>(ServiceContext))) };
+
+	for (const auto& FilterHash : FilterHashes)
+	{
+		Hash = HashCombine(Hash, FilterHash);
+	}
+
+	return Hash;
+}
+
+FString ULobbySearchRequest::GetCanonicalKey() const
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	// Values are prefixed with their length so that they cannot be confused with the separators
+
+	TArray<FString, TInlineAllocator<8>> FilterKeys;
+	FilterKeys.Reserve(Filters.Num());
+
+	for (const auto& Filter : Filters)
+	{
+		const auto Value{ Filter.Attribute.GetAttributeAsString() };
+
+		FilterKeys.Emplace(FString::Printf(TEXT("%s:%d:%d:%d:%s")
+			, *DevSettings->RedirectLobbyAttribute_ToOnlineService(Filter.Attribute.GetAttributeName()).ToString()
+			, static_cast<int32>(Filter.ComparisonOp)
+			, static_cast<int32>(Filter.Attribute.GetValueType())
+			, Value.Len()
+			, *Value));
+	}
+
+	FilterKeys.Sort();
+
+	auto Key{ FString::Printf(TEXT("%d:%d"), MaxResult, static_cast<int32>(ServiceContext)) };
+
+	for (const auto& FilterKey : FilterKeys)
+	{
+		Key += TEXT("|");
+		Key += FilterKey;
+	}
+
+	return Key;
+}
+
+bool ULobbySearchRequest::ValidateAndLogErrors(FString& OutError) const
+{
+	const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+	for (const auto& Filter : Filters)
+	{
+		if (!DevSettings->ValidateLobbyAttribute(Filter.Attribute, true, OutError))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ULobbySearchRequest::AddFilterByIndex(int32 SchemaIndex, FLobbyAttribute Attribute, ELobbyAttributeComparisonOp ComparisonOp)
+{
+	const auto* Entry{ GetDefault<UOnlineDeveloperSettings>()->GetLobbyAttributeSchemaEntry(SchemaIndex) };
+
+	if (!Entry || !Entry->bSearchable || (Entry->Type != Attribute.GetValueType()))
+	{
+		return false;
+	}
+
+	Attribute.SetAttributeName(Entry->Name);
+
+	Filters.Emplace(FLobbyAttributeFilter(MoveTemp(Attribute), ComparisonOp));
+	return true;
+}
+
+ULobbySearchRequest* ULobbySearchRequest::CreateWidenedRequest(int32 StepIndex, UObject* Outer) const
+{
+	auto* NewRequest{ NewObject<ULobbySearchRequest>(Outer ? Outer : GetOuter(), GetClass()) };
+	NewRequest->MaxResult = MaxResult;
+	NewRequest->Filters = Filters;
+	NewRequest->ServiceContext = ServiceContext;
+	NewRequest->ContextSearchDeadline = ContextSearchDeadline;
+	NewRequest->bUseCachedResults = bUseCachedResults;
+	NewRequest->bCreateResultObjects = bCreateResultObjects;
+	NewRequest->bExcludeBlacklistedLobbies = bExcludeBlacklistedLobbies;
+
+	for (auto Index{ 0 }; (Index <= StepIndex) && WideningSteps.IsValidIndex(Index); ++Index)
+	{
+		WideningSteps[Index].ApplyTo(NewRequest->Filters);
+	}
+
+	return NewRequest;
+}
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "Type/OnlineServiceResultTypes.h"
+#include "Type/OnlineServiceContextTypes.h"
 #include "Type/OnlineLobbyAttributeTypes.h"
+#include "Type/OnlineLobbyViewTypes.h"
 
 #include "Online/Lobbies.h"
 
@@ -23,6 +25,47 @@ class ULobbyResult;
 DECLARE_DELEGATE_TwoParams(FLobbySearchCompleteDelegate, ULobbySearchRequest*/*Request*/, FOnlineServiceResult/*Result*/);
 
 
+////////////////////////////////////////////////////////////////////////
+// Structs
+
+/**
+ * Step to relax the filters of a lobby search when no lobby has been found
+ * 
+ * Tips:
+ *	Steps are applied cumulatively, so each step only lists the changes from the previous one.
+ */
+USTRUCT(BlueprintType)
+struct GCONLINE_API FLobbySearchWideningStep
+{
+	GENERATED_BODY()
+public:
+	FLobbySearchWideningStep() = default;
+
+public:
+	//
+	// Time in seconds from the start of the previous search until the search with this step starts
+	//
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0.0, Units = "s"))
+	float Delay{ 5.0f };
+
+	//
+	// Name of the attributes whose filters are removed
+	//
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FName> FiltersToRemove;
+
+	//
+	// Filters to add, replacing the filters of the same attribute
+	//
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FLobbyAttributeFilter> FiltersToSet;
+
+public:
+	void ApplyTo(TSet<FLobbyAttributeFilter>& InOutFilters) const;
+
+};
+
+
 ////////////////////////////////////////////////////////////////////////
 // Objects
 
@@ -51,12 +94,107 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
 	TSet<FLobbyAttributeFilter> Filters;
 
+	//
+	// Service context to search lobbies in, ignored by searches across all contexts
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	EOnlineServiceContext ServiceContext{ EOnlineServiceContext::Default };
+
+	//
+	// Time in seconds each context has to complete in a search across all contexts, the results of slower contexts are dropped
+	// 
+	// Tips:
+	//	Set to 0 to wait for all contexts.
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	float ContextSearchDeadline{ 0.0f };
+
+	//
+	// Whether recent results of an equivalent search may be returned instead of searching again
+	// 
+	// Tips:
+	//	Only works when the lobby search result cache is enabled in the developer settings.
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	bool bUseCachedResults{ true };
+
+	//
+	// Whether to refresh the results of the previous search in place instead of rebuilding them
+	// 
+	// Tips:
+	//	Result objects of lobbies that are still found are reused and updated, 
+	//	and the differences from the previous search are listed in AddedResults, RemovedResults and ChangedResults.
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	bool bIncrementalRefresh{ false };
+
+	//
+	// Whether to create result objects for the lobbies found
+	// 
+	// Tips:
+	//	Native code that only reads ResultViews can disable this to avoid allocating UObjects for each lobby.
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	bool bCreateResultObjects{ true };
+
+	//
+	// Whether to exclude lobbies that recently failed to be joined from the results
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	bool bExcludeBlacklistedLobbies{ true };
+
+	//
+	// Steps to relax the filters when no lobby is found, used by QuickPlay
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	TArray<FLobbySearchWideningStep> WideningSteps;
+
+	//
+	// Time in seconds from the first search after which no more widened searches are started
+	// 
+	// Tips:
+	//	Set to 0 to run all widening steps regardless of the time.
+	//
+	UPROPERTY(BlueprintReadWrite, Category = "Lobby")
+	float WideningDeadline{ 0.0f };
+
 public:
 	/**
 	 * Generate parameters for lobby search from current settings
 	 */
 	FFindLobbies::Params GenerateFindParameters() const;
 
+	/**
+	 * Returns a hash of the search parameters that does not depend on the order of the filters
+	 * 
+	 * Tips:
+	 *	Attribute names are hashed after redirection, so requests that end up sending the same parameters have the same hash.
+	 */
+	uint32 GetCanonicalHash() const;
+
+	/**
+	 * Returns the search parameters as text that does not depend on the order of the filters
+	 * 
+	 * Tips:
+	 *	Requests with the same key send the same parameters, used to tell apart requests whose canonical hashes collide.
+	 */
+	FString GetCanonicalKey() const;
+
+	/**
+	 * Returns true if this request is valid, returns false and logs errors if it is not
+	 */
+	virtual bool ValidateAndLogErrors(FString& OutError) const;
+
+	/**
+	 * Adds a filter on the attribute declared at the index of the lobby attribute schema, returns false if it cannot be used as a filter
+	 */
+	bool AddFilterByIndex(int32 SchemaIndex, FLobbyAttribute Attribute, ELobbyAttributeComparisonOp ComparisonOp);
+
+	/**
+	 * Creates a copy of this request with the widening steps up to the index applied to the filters
+	 */
+	ULobbySearchRequest* CreateWidenedRequest(int32 StepIndex, UObject* Outer) const;
+
 
 	///////////////////////////////////////////////
 	// Search Result
@@ -67,4 +205,32 @@ public:
 	UPROPERTY(BlueprintReadOnly, Transient, Category = "Lobby")
 	TArray<TObjectPtr<ULobbyResult>> Results;
 
+	//
+	// Lightweight views of the lobbies found, in the same order as Results
+	//
+	TArray<FLobbyView> ResultViews;
+
+	//
+	// Service context each lobby was found in, in the same order as ResultViews
+	//
+	TArray<EOnlineServiceContext> ResultContexts;
+
+	//
+	// Results of lobbies that were not found in the previous search (bIncrementalRefresh only)
+	//
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Lobby")
+	TArray<TObjectPtr<ULobbyResult>> AddedResults;
+
+	//
+	// Results of lobbies found in the previous search that are no longer found (bIncrementalRefresh only)
+	//
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Lobby")
+	TArray<TObjectPtr<ULobbyResult>> RemovedResults;
+
+	//
+	// Results of lobbies found in both searches whose state has changed (bIncrementalRefresh only)
+	//
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Lobby")
+	TArray<TObjectPtr<ULobbyResult>> ChangedResults;
+
 };
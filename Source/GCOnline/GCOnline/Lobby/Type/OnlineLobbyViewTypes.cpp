@@ -0,0 +1,137 @@
+// Copyright (C) 2024 owoDra
+
+#include "OnlineLobbyViewTypes.h"
+
+#include "OnlineDeveloperSettings.h"
+
+
+/////////////////////////////////////////////////////////////////
+// FLobbyView
+
+FLobbyView::FLobbyView(const TSharedPtr<const FLobby>& InLobby)
+	: Lobby(InLobby)
+{
+}
+
+void FLobbyView::BuildAttributeIndex() const
+{
+	bAttributeIndexBuilt = true;
+
+	if (Lobby)
+	{
+		const auto* DevSettings{ GetDefault<UOnlineDeveloperSettings>() };
+
+		AttributeIndex.Reserve(Lobby->Attributes.Num());
+
+		for (const auto& KVP : Lobby->Attributes)
+		{
+			AttributeIndex.Emplace(DevSettings->RedirectLobbyAttribute_ToProject(KVP.Key), KVP.Key);
+		}
+	}
+}
+
+
+// Lobby Info
+
+FName FLobbyView::GetLocalName() const
+{
+	return Lobby ? Lobby->LocalName : NAME_None;
+}
+
+FAccountId FLobbyView::GetOwnerAccountId() const
+{
+	return Lobby ? Lobby->OwnerAccountId : FAccountId();
+}
+
+FLobbyId FLobbyView::GetLobbyId() const
+{
+	return Lobby ? Lobby->LobbyId : FLobbyId();
+}
+
+
+// Lobby Attribute
+
+const FSchemaVariant* FLobbyView::FindLobbyAttribute(FName Key) const
+{
+	if (Lobby)
+	{
+		if (!bAttributeIndexBuilt)
+		{
+			BuildAttributeIndex();
+		}
+
+		if (const auto* ServiceKey{ AttributeIndex.Find(Key) })
+		{
+			return Lobby->Attributes.Find(*ServiceKey);
+		}
+	}
+
+	return nullptr;
+}
+
+const FSchemaVariant* FLobbyView::FindLobbyAttribute(const FLobbyAttributeHandle& Handle) const
+{
+	return Lobby ? Lobby->Attributes.Find(Handle.GetServiceName()) : nullptr;
+}
+
+bool FLobbyView::GetLobbyAttributeAsString(FName Key, FString& OutValue) const
+{
+	if (const auto* VariantValue{ FindLobbyAttribute(Key) })
+	{
+		OutValue = VariantValue->GetString();
+		return true;
+	}
+
+	return false;
+}
+
+bool FLobbyView::GetLobbyAttributeAsInteger(FName Key, int32& OutValue) const
+{
+	if (const auto* VariantValue{ FindLobbyAttribute(Key) })
+	{
+		OutValue = VariantValue->GetInt64();
+		return true;
+	}
+
+	return false;
+}
+
+bool FLobbyView::GetLobbyAttributeAsDouble(FName Key, double& OutValue) const
+{
+	if (const auto* VariantValue{ FindLobbyAttribute(Key) })
+	{
+		OutValue = VariantValue->GetDouble();
+		return true;
+	}
+
+	return false;
+}
+
+bool FLobbyView::GetLobbyAttributeAsBoolean(FName Key, bool& OutValue) const
+{
+	if (const auto* VariantValue{ FindLobbyAttribute(Key) })
+	{
+		OutValue = VariantValue->GetBoolean();
+		return true;
+	}
+
+	return false;
+}
+
+
+// Lobby Status
+
+int32 FLobbyView::GetMaxMembers() const
+{
+	return Lobby ? Lobby->MaxMembers : 0;
+}
+
+int32 FLobbyView::GetNumMembers() const
+{
+	return Lobby ? Lobby->Members.Num() : 0;
+}
+
+int32 FLobbyView::GetNumOpenSlot() const
+{
+	return GetMaxMembers() - GetNumMembers();
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Type/OnlineLobbyAttributeTypes.h"
+
+#include "Online/Lobbies.h"
+
+using namespace UE::Online;
+
+
+/**
+ * Lightweight read-only view of a lobby for native code
+ *
+ * Tips:
+ *	Unlike ULobbyResult, this is not a UObject, so it can be created and copied without GC cost.
+ *	Attribute names are resolved to project names once on the first read by name, so views that are never read cost only the lobby pointer.
+ *	Use ULobbyResult::CreateFromView() when the lobby needs to be passed to Blueprint.
+ */
+struct GCONLINE_API FLobbyView
+{
+public:
+	FLobbyView() = default;
+	explicit FLobbyView(const TSharedPtr<const FLobby>& InLobby);
+
+protected:
+	//
+	// Pointer to the platform-specific implementation
+	//
+	TSharedPtr<const FLobby> Lobby;
+
+	//
+	// Attribute keys on the online service indexed by the name used in the project, built on the first read by name
+	//
+	// Key   : Name to be used for the project
+	// Value : Name on online service
+	//
+	mutable TMap<FName, FSchemaAttributeId> AttributeIndex;
+
+	mutable bool bAttributeIndexBuilt{ false };
+
+	void BuildAttributeIndex() const;
+
+public:
+	bool IsValid() const { return Lobby.IsValid(); }
+
+	const TSharedPtr<const FLobby>& GetLobby() const { return Lobby; }
+
+
+	///////////////////////////////////////////////////
+	// Lobby Info
+public:
+	FName GetLocalName() const;
+	FAccountId GetOwnerAccountId() const;
+	FLobbyId GetLobbyId() const;
+
+
+	///////////////////////////////////////////////////
+	// Lobby Attribute
+public:
+	/**
+	 * Returns the attribute value for the name used in the project, will return null if there is no attribute
+	 */
+	const FSchemaVariant* FindLobbyAttribute(FName Key) const;
+	const FSchemaVariant* FindLobbyAttribute(const FLobbyAttributeHandle& Handle) const;
+
+	bool GetLobbyAttributeAsString(FName Key, FString& OutValue) const;
+	bool GetLobbyAttributeAsInteger(FName Key, int32& OutValue) const;
+	bool GetLobbyAttributeAsDouble(FName Key, double& OutValue) const;
+	bool GetLobbyAttributeAsBoolean(FName Key, bool& OutValue) const;
+
+
+	///////////////////////////////////////////////////
+	// Lobby Status
+public:
+	int32 GetMaxMembers() const;
+	int32 GetNumMembers() const;
+	int32 GetNumOpenSlot() const;
+
+};
@@ -115,6 +115,26 @@ UOnlineLocalUserSubsystem* UOnlineLocalUserManagerSubsystem::GetUserInfoForPlatf
 	return nullptr;
 }
 
+TArray<UOnlineLocalUserSubsystem*> UOnlineLocalUserManagerSubsystem::GetInitializedLocalUsers(bool bIncludeGuests) const
+{
+	TArray<UOnlineLocalUserSubsystem*> LocalUsers;
+
+	if (auto* GameInstance{ GetGameInstance() })
+	{
+		for (auto It{ GameInstance->GetLocalPlayerIterator() }; It; ++It)
+		{
+			auto* LocalUser{ ULocalPlayer::GetSubsystem<UOnlineLocalUserSubsystem>(*It) };
+
+			if (LocalUser && LocalUser->HasLocalUserInitialized() && (bIncludeGuests || !LocalUser->bIsGuest))
+			{
+				LocalUsers.Emplace(LocalUser);
+			}
+		}
+	}
+
+	return LocalUsers;
+}
+
 UOnlineLocalUserSubsystem* UOnlineLocalUserManagerSubsystem::GetUserInfoForUniqueNetId(const FUniqueNetIdRepl& NetId) const
 {
 	if (!NetId.IsValid())
@@ -83,6 +83,12 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure = False, Category = "Local User")
     UOnlineLocalUserSubsystem* GetUserInfoForInputDevice(FInputDeviceId InputDevice) const;
 
+    /**
+     * Returns the user info of all local players that have been initialized as local users, in local player order
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure = False, Category = "Local User")
+    TArray<UOnlineLocalUserSubsystem*> GetInitializedLocalUsers(bool bIncludeGuests = false) const;
+
 public:
     /** 
      * Returns true if this this could be a real platform user with a valid identity (even if not currently logged in) 
@@ -2,6 +2,10 @@
 
 #include "OnlineDeveloperSettings.h"
 
+#include "Type/OnlineLobbyRankingTypes.h"
+
+#include "GCOnlineLogs.h"
+
 #include "Online/OnlineSessionNames.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(OnlineDeveloperSettings)
@@ -61,8 +65,55 @@ UOnlineDeveloperSettings::UOnlineDeveloperSettings()
 		{ SETTING_GAMEMODE, FName(TEXT("LOBBYSERVICEATTRIBUTE1")) },
 		{ SETTING_MAPNAME, FName(TEXT("LOBBYSERVICEATTRIBUTE2")) },
 	};
+
+	LobbyBlacklistDurations =
+	{
+		{ ELobbyJoinFailureReason::Unknown, 0.0f },
+		{ ELobbyJoinFailureReason::Full, 30.0f },
+		{ ELobbyJoinFailureReason::NotFound, 120.0f },
+		{ ELobbyJoinFailureReason::JoinPolicy, 60.0f },
+	};
+
+	LobbyOperationTimeouts =
+	{
+		{ ELobbyOperationType::Create, 30.0f },
+		{ ELobbyOperationType::Search, 30.0f },
+		{ ELobbyOperationType::Join, 30.0f },
+		{ ELobbyOperationType::Modify, 30.0f },
+		{ ELobbyOperationType::Leave, 30.0f },
+	};
+}
+
+void UOnlineDeveloperSettings::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	RebuildAttributeRedirectTables();
+}
+
+void UOnlineDeveloperSettings::PostReloadConfig(FProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+
+	RebuildAttributeRedirectTables();
 }
 
+#if WITH_EDITOR
+void UOnlineDeveloperSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const auto PropertyName{ PropertyChangedEvent.GetMemberPropertyName() };
+
+	if ((PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, LobbyAttributeRedirects)) ||
+		(PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, LobbyUserAttributeRedirects)) ||
+		(PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, LobbyAttributeSchema)))
+	{
+		RebuildAttributeRedirectTables();
+	}
+}
+#endif
+
 
 // Privileges
 
@@ -95,26 +146,161 @@ FText UOnlineDeveloperSettings::GetPrivilegesResultDescription(EOnlineServiceCon
 
 // Lobbies
 
+const ULobbyRankingPolicy* UOnlineDeveloperSettings::GetQuickPlayRankingPolicy() const
+{
+	const auto* PolicyClass{ QuickPlayRankingPolicyClass.IsNull() ? nullptr : QuickPlayRankingPolicyClass.LoadSynchronous() };
+
+	return GetDefault<ULobbyRankingPolicy>(PolicyClass ? PolicyClass : ULobbyRankingPolicy::StaticClass());
+}
+
+double UOnlineDeveloperSettings::GetLobbyBlacklistDuration(ELobbyJoinFailureReason Reason) const
+{
+	auto* Found{ LobbyBlacklistDurations.Find(Reason) };
+	return Found ? FMath::Max(*Found, 0.0f) : 0.0;
+}
+
+float UOnlineDeveloperSettings::GetLobbyOperationTimeout(ELobbyOperationType Type) const
+{
+	auto* Found{ LobbyOperationTimeouts.Find(Type) };
+	return Found ? FMath::Max(*Found, 0.0f) : 0.0f;
+}
+
 FName UOnlineDeveloperSettings::RedirectLobbyAttribute_ToOnlineService(const FName& InName) const
 {
-	auto* Found{ LobbyAttributeRedirects.Find(InName) };
+	auto* Found{ LobbyAttributeToOnlineService.Find(InName) };
 	return Found ? *Found : InName;
 }
 
 FName UOnlineDeveloperSettings::RedirectLobbyAttribute_ToProject(const FName& InName) const
 {
-	auto* Found{ LobbyAttributeRedirects.FindKey(InName) };
+	auto* Found{ LobbyAttributeToProject.Find(InName) };
 	return Found ? *Found : InName;
 }
 
 FName UOnlineDeveloperSettings::RedirectUserLobbyAttribute_ToOnlineService(const FName& InName) const
 {
-	auto* Found{ LobbyUserAttributeRedirects.Find(InName) };
+	auto* Found{ UserLobbyAttributeToOnlineService.Find(InName) };
 	return Found ? *Found : InName;
 }
 
 FName UOnlineDeveloperSettings::RedirectUserLobbyAttribute_ToProject(const FName& InName) const
 {
-	auto* Found{ LobbyUserAttributeRedirects.FindKey(InName) };
+	auto* Found{ UserLobbyAttributeToProject.Find(InName) };
 	return Found ? *Found : InName;
 }
+
+void UOnlineDeveloperSettings::RebuildAttributeRedirectTables()
+{
+	auto BuildTables
+	{
+		[](const TMap<FName, FName>& Redirects, TMap<FName, FName>& OutForward, TMap<FName, FName>& OutReverse)
+		{
+			OutForward.Reset();
+			OutReverse.Reset();
+			OutForward.Reserve(Redirects.Num());
+			OutReverse.Reserve(Redirects.Num());
+
+			for (const auto& KVP : Redirects)
+			{
+				OutForward.Emplace(KVP.Key, KVP.Value);
+
+				// Keep the first entry, same as the previous FindKey behavior
+
+				if (!OutReverse.Contains(KVP.Value))
+				{
+					OutReverse.Emplace(KVP.Value, KVP.Key);
+				}
+			}
+
+			OutForward.Compact();
+			OutReverse.Compact();
+		}
+	};
+
+	BuildTables(LobbyAttributeRedirects, LobbyAttributeToOnlineService, LobbyAttributeToProject);
+	BuildTables(LobbyUserAttributeRedirects, UserLobbyAttributeToOnlineService, UserLobbyAttributeToProject);
+
+	// Compile the schema, the service names declared in it take priority over the redirect list
+
+	CompiledLobbyAttributeSchema.Reset(LobbyAttributeSchema.Num());
+	LobbyAttributeSchemaIndices.Reset();
+	LobbyAttributeSchemaIndices.Reserve(LobbyAttributeSchema.Num());
+
+	for (auto Index{ 0 }; Index < LobbyAttributeSchema.Num(); ++Index)
+	{
+		const auto& Entry{ LobbyAttributeSchema[Index] };
+
+		// Keep a placeholder for invalid entries so the compiled indices stay the same as the declared indices
+
+		if (Entry.Name.IsNone() || LobbyAttributeSchemaIndices.Contains(Entry.Name))
+		{
+			UE_LOG(LogGameCore_OnlineLobbies, Error, TEXT("Lobby attribute schema entry [%d] is ignored because its name is %s (%s)")
+				, Index, Entry.Name.IsNone() ? TEXT("not set") : TEXT("already declared"), *Entry.Name.ToString());
+
+			CompiledLobbyAttributeSchema.AddDefaulted();
+			continue;
+		}
+
+		auto& CompiledEntry{ CompiledLobbyAttributeSchema.Add_GetRef(Entry) };
+
+		if (CompiledEntry.ServiceName.IsNone())
+		{
+			CompiledEntry.ServiceName = RedirectLobbyAttribute_ToOnlineService(CompiledEntry.Name);
+		}
+		else
+		{
+			LobbyAttributeToOnlineService.Emplace(CompiledEntry.Name, CompiledEntry.ServiceName);
+			LobbyAttributeToProject.Emplace(CompiledEntry.ServiceName, CompiledEntry.Name);
+		}
+
+		LobbyAttributeSchemaIndices.Emplace(CompiledEntry.Name, CompiledLobbyAttributeSchema.Num() - 1);
+	}
+
+	++AttributeRedirectGeneration;
+}
+
+int32 UOnlineDeveloperSettings::FindLobbyAttributeSchemaIndex(const FName& InName) const
+{
+	auto* Found{ LobbyAttributeSchemaIndices.Find(InName) };
+	return Found ? *Found : INDEX_NONE;
+}
+
+const FLobbyAttributeSchemaEntry* UOnlineDeveloperSettings::GetLobbyAttributeSchemaEntry(int32 SchemaIndex) const
+{
+	if (!CompiledLobbyAttributeSchema.IsValidIndex(SchemaIndex))
+	{
+		return nullptr;
+	}
+
+	// Placeholders of invalid entries have no name
+
+	const auto& Entry{ CompiledLobbyAttributeSchema[SchemaIndex] };
+	return Entry.Name.IsNone() ? nullptr : &Entry;
+}
+
+bool UOnlineDeveloperSettings::ValidateLobbyAttribute(const FLobbyAttribute& InAttribute, bool bAsSearchFilter, FString& OutError) const
+{
+	const auto* Entry{ GetLobbyAttributeSchemaEntry(FindLobbyAttributeSchemaIndex(InAttribute.GetAttributeName())) };
+
+	if (!Entry)
+	{
+		return true;
+	}
+
+	if (Entry->Type != InAttribute.GetValueType())
+	{
+		OutError = FString::Printf(TEXT("Lobby attribute (%s) must be %s but was %s.")
+			, *Entry->Name.ToString()
+			, *StaticEnum<ELobbyAttributeValueType>()->GetNameStringByValue(static_cast<int64>(Entry->Type))
+			, *StaticEnum<ELobbyAttributeValueType>()->GetNameStringByValue(static_cast<int64>(InAttribute.GetValueType())));
+		return false;
+	}
+
+	if (bAsSearchFilter && !Entry->bSearchable)
+	{
+		OutError = FString::Printf(TEXT("Lobby attribute (%s) is not searchable."), *Entry->Name.ToString());
+		return false;
+	}
+
+	return true;
+}
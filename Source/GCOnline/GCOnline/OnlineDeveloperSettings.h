@@ -7,9 +7,13 @@
 #include "Type/OnlineServiceContextTypes.h"
 #include "Type/OnlinePrivilegeTypes.h"
 #include "Type/OnlineLobbyCreateTypes.h"
+#include "Type/OnlineLobbyBlacklistTypes.h"
+#include "Type/OnlineLobbyOperationTypes.h"
 
 #include "OnlineDeveloperSettings.generated.h"
 
+class ULobbyRankingPolicy;
+
 
 /**
  * Description of the user's privileges with respect to the online service
@@ -41,6 +45,12 @@ public:
 public:
 	UOnlineDeveloperSettings();
 
+	virtual void PostInitProperties() override;
+	virtual void PostReloadConfig(FProperty* PropertyThatWasLoaded) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 
 	///////////////////////////////////////////////
 	// Privileges
@@ -83,21 +93,286 @@ protected:
 	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies", meta = (ForceInlineRow))
 	TMap<FName, FName> LobbyUserAttributeRedirects;
 
+	//
+	// Declaration of the lobby attributes used in the project
+	// 
+	// Tips:
+	//	Each entry is accessed by its index in this list, so lobby results can read attributes without hashing the name.
+	//	Attributes with the wrong type and filters on attributes that are not searchable are rejected before being sent.
+	//	Attributes not listed here can still be used by name without validation.
+	//	Entries without a name or with a name already declared are ignored, but keep their index.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Schema", meta = (TitleProperty = "Name"))
+	TArray<FLobbyAttributeSchemaEntry> LobbyAttributeSchema;
+
 	//
 	// Online mode for lobbies to be created by default
 	//
 	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies")
 	ELobbyOnlineMode DefaultLobbyOnlineMode{ ELobbyOnlineMode::Online };
 
+	//
+	// Time in seconds that lobby search results are served from the cache without searching again
+	// 
+	// Tips:
+	//	Set to 0 to disable the lobby search result cache.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Search Cache", meta = (ClampMin = 0.0, Units = "s"))
+	float LobbySearchCacheFreshTime{ 0.0f };
+
+	//
+	// Additional time in seconds that outdated search results are still served while they are refreshed in the background
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Search Cache", meta = (ClampMin = 0.0, Units = "s"))
+	float LobbySearchCacheStaleTime{ 0.0f };
+
+	//
+	// Maximum memory in kilobytes used to retain lobby snapshots in the search result cache
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Search Cache", meta = (ClampMin = 0, Units = "KB"))
+	int32 LobbySearchCacheMemoryBudget{ 1024 };
+
+	//
+	// Time in seconds that lobby attribute modifications are queued and merged before being sent
+	// 
+	// Tips:
+	//	The window starts at the first queued modification, so frequent modifications are still sent at this interval.
+	//	Set to 0 to send each modification immediately.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Modify", meta = (ClampMin = 0.0, Units = "s"))
+	float LobbyAttributeModifyDebounceTime{ 0.0f };
+
+	//
+	// Whether to queue lobby events and notify them once per frame
+	// 
+	// Tips:
+	//	Redundant events of the same lobby are merged, for example only the latest member count is notified.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Events")
+	bool bCoalesceLobbyEvents{ false };
+
+	//
+	// Policy class used to rank lobby search results when choosing a lobby to join in QuickPlay
+	// 
+	// Tips:
+	//	If not set, ULobbyRankingPolicy with its default scorers is used.
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Lobbies|QuickPlay")
+	TSoftClassPtr<ULobbyRankingPolicy> QuickPlayRankingPolicyClass;
+
+	//
+	// Time in seconds that join failures and latencies observed for a lobby are kept
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|QuickPlay", meta = (ClampMin = 0.0, Units = "s"))
+	float LobbyHistoryRetentionTime{ 300.0f };
+
+	//
+	// Maximum number of lobbies that QuickPlay tries to join before creating a new lobby
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|QuickPlay", meta = (ClampMin = 1))
+	int32 QuickPlayMaxJoinAttempts{ 3 };
+
+	//
+	// Time in seconds from the end of the search after which QuickPlay stops trying other lobbies and fails
+	// 
+	// Tips:
+	//	Set to 0 to try candidates without a time limit.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|QuickPlay", meta = (ClampMin = 0.0, Units = "s"))
+	float QuickPlayJoinDeadline{ 0.0f };
+
+	//
+	// Time in seconds from the start of QuickPlay after which it prepares to create a lobby while the search is still in progress
+	// 
+	// Tips:
+	//	Only used when QuickPlay is allowed to host. Set to 0 to wait for the search before preparing the creation.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|QuickPlay", meta = (ClampMin = 0.0, Units = "s"))
+	float QuickPlayHedgeDelay{ 0.0f };
+
+	//
+	// Whether QuickPlay also starts creating the lobby once the hedge delay has passed, instead of only preparing the creation
+	// 
+	// Tips:
+	//	If the search finds a lobby before the creation completes, the created lobby is left and the found lobby is joined.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|QuickPlay", meta = (EditCondition = "QuickPlayHedgeDelay > 0.0"))
+	bool bQuickPlayHedgeCreate{ false };
+
+	//
+	// Time in seconds that a lobby is excluded from search results and QuickPlay after joining it has failed, for each reason
+	// 
+	// Tips:
+	//	Set to 0 to keep lobbies that failed for the reason in the results.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Blacklist", meta = (EditFixedSize, ReadOnlyKeys, ForceInlineRow, ClampMin = 0.0, Units = "s"))
+	TMap<ELobbyJoinFailureReason, float> LobbyBlacklistDurations;
+
+	//
+	// Whether to start loading the map of the lobby while it is being created or joined
+	// 
+	// Tips:
+	//	The loaded map is kept until the travel to the lobby has finished, and released if the lobby operation fails.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Travel")
+	bool bPreloadLobbyMap{ false };
+
+	//
+	// Whether to start joining the lobby as soon as an invite is received, before the game accepts it
+	// 
+	// Tips:
+	//	The joined lobby is staged until ConfirmStagedLobbyInvite or RejectStagedLobbyInvite is called on the lobby subsystem.
+	//	The map of the lobby is preloaded while joining even if bPreloadLobbyMap is disabled.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Invite")
+	bool bSpeculativeInviteJoin{ false };
+
+	//
+	// Time in seconds that a staged invite waits for the game to accept it before the lobby is left
+	// 
+	// Tips:
+	//	Set to 0 to wait indefinitely.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Invite", meta = (EditCondition = "bSpeculativeInviteJoin", ClampMin = 0.0, Units = "s"))
+	float StagedInviteTimeout{ 60.0f };
+
+	//
+	// Lobby attribute through which the party leader hands the party off to a game lobby
+	// 
+	// Tips:
+	//	Must be declared as a string attribute in the lobby schema of the party lobby.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Handoff")
+	FName LobbyHandoffAttributeName{ TEXT("LOBBYHANDOFF") };
+
+	//
+	// Whether party members start joining the game lobby as soon as the leader hands it off
+	// 
+	// Tips:
+	//	If disabled, the game has to join with the request passed to OnLobbyHandoffReceived.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Handoff")
+	bool bAutoJoinLobbyHandoff{ true };
+
+	//
+	// Time in seconds after which a lobby operation in progress is cancelled and completed with a timeout error, for each operation type
+	// 
+	// Tips:
+	//	Set to 0 to wait for the online service indefinitely.
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Lobbies|Deadline", meta = (EditFixedSize, ReadOnlyKeys, ForceInlineRow, ClampMin = 0.0, Units = "s"))
+	TMap<ELobbyOperationType, float> LobbyOperationTimeouts;
+
+	//
+	// Interval in seconds at which the deadlines of lobby operations are checked
+	// 
+	// Tips:
+	//	Operations time out up to this much later than their deadline.
+	//
+	UPROPERTY(Config, BlueprintReadOnly, EditAnywhere, Category = "Lobbies|Deadline", meta = (ClampMin = 0.01, Units = "s"))
+	float LobbyOperationDeadlineResolution{ 0.25f };
+
 public:
 	UFUNCTION(BlueprintCallable, Category = "Lobbies")
 	static ELobbyOnlineMode GetDefaultLobbyOnlineMode() { return GetDefault<UOnlineDeveloperSettings>()->DefaultLobbyOnlineMode; }
 
+	bool IsLobbySearchCacheEnabled() const { return LobbySearchCacheFreshTime > 0.0f; }
+	double GetLobbySearchCacheFreshTime() const { return LobbySearchCacheFreshTime; }
+	double GetLobbySearchCacheStaleTime() const { return LobbySearchCacheStaleTime; }
+	SIZE_T GetLobbySearchCacheMemoryBudget() const { return static_cast<SIZE_T>(LobbySearchCacheMemoryBudget) * 1024; }
+
+	bool IsLobbyAttributeModifyDebounceEnabled() const { return LobbyAttributeModifyDebounceTime > 0.0f; }
+	float GetLobbyAttributeModifyDebounceTime() const { return LobbyAttributeModifyDebounceTime; }
+
+	bool ShouldCoalesceLobbyEvents() const { return bCoalesceLobbyEvents; }
+
+	/**
+	 * Returns the default object of the ranking policy used by QuickPlay
+	 */
+	const ULobbyRankingPolicy* GetQuickPlayRankingPolicy() const;
+
+	double GetLobbyHistoryRetentionTime() const { return LobbyHistoryRetentionTime; }
+
+	int32 GetQuickPlayMaxJoinAttempts() const { return FMath::Max(QuickPlayMaxJoinAttempts, 1); }
+	double GetQuickPlayJoinDeadline() const { return QuickPlayJoinDeadline; }
+
+	bool IsQuickPlayHedgeEnabled() const { return QuickPlayHedgeDelay > 0.0f; }
+	float GetQuickPlayHedgeDelay() const { return QuickPlayHedgeDelay; }
+	bool ShouldQuickPlayHedgeCreate() const { return bQuickPlayHedgeCreate; }
+
+	double GetLobbyBlacklistDuration(ELobbyJoinFailureReason Reason) const;
+
+	bool ShouldPreloadLobbyMap() const { return bPreloadLobbyMap; }
+
+	bool ShouldSpeculativeInviteJoin() const { return bSpeculativeInviteJoin; }
+	float GetStagedInviteTimeout() const { return StagedInviteTimeout; }
+
+	const FName& GetLobbyHandoffAttributeName() const { return LobbyHandoffAttributeName; }
+	bool ShouldAutoJoinLobbyHandoff() const { return bAutoJoinLobbyHandoff; }
+
+	float GetLobbyOperationTimeout(ELobbyOperationType Type) const;
+	float GetLobbyOperationDeadlineResolution() const { return FMath::Max(LobbyOperationDeadlineResolution, 0.01f); }
+
 	FName RedirectLobbyAttribute_ToOnlineService(const FName& InName) const;
 	FName RedirectLobbyAttribute_ToProject(const FName& InName) const;
 
 	FName RedirectUserLobbyAttribute_ToOnlineService(const FName& InName) const;
 	FName RedirectUserLobbyAttribute_ToProject(const FName& InName) const;
 
+	/**
+	 * Returns the number of times the redirect tables have been rebuilt, used to detect outdated attribute handles
+	 */
+	uint32 GetAttributeRedirectGeneration() const { return AttributeRedirectGeneration; }
+
+	/**
+	 * Returns the lobby attribute schema with the service names resolved, invalid entries are kept as placeholders without a name
+	 */
+	const TArray<FLobbyAttributeSchemaEntry>& GetLobbyAttributeSchema() const { return CompiledLobbyAttributeSchema; }
+
+	/**
+	 * Returns the index of the lobby attribute in the schema, will return INDEX_NONE if not declared
+	 */
+	int32 FindLobbyAttributeSchemaIndex(const FName& InName) const;
+
+	/**
+	 * Returns the schema entry of the index, will return null if the index or the declared entry is invalid
+	 */
+	const FLobbyAttributeSchemaEntry* GetLobbyAttributeSchemaEntry(int32 SchemaIndex) const;
+
+	/**
+	 * Returns false if the attribute is declared in the schema with a different type, or is used as a filter while not searchable
+	 */
+	bool ValidateLobbyAttribute(const FLobbyAttribute& InAttribute, bool bAsSearchFilter, FString& OutError) const;
+
+protected:
+	/**
+	 * Compiles the redirect lists and the schema into the lookup tables used at runtime
+	 */
+	void RebuildAttributeRedirectTables();
+
+private:
+	//
+	// Compiled lookup tables of the lobby attribute redirects
+	// 
+	// Tips:
+	//	Built from LobbyAttributeRedirects when the settings are loaded or changed, so both directions are hash lookups.
+	//
+	TMap<FName, FName> LobbyAttributeToOnlineService;
+	TMap<FName, FName> LobbyAttributeToProject;
+
+	//
+	// Compiled lookup tables of the lobby user attribute redirects
+	//
+	TMap<FName, FName> UserLobbyAttributeToOnlineService;
+	TMap<FName, FName> UserLobbyAttributeToProject;
+
+	//
+	// Compiled lobby attribute schema and index of its entries by project name
+	//
+	TArray<FLobbyAttributeSchemaEntry> CompiledLobbyAttributeSchema;
+	TMap<FName, int32> LobbyAttributeSchemaIndices;
+
+	uint32 AttributeRedirectGeneration{ 0 };
+
 };
 